@@ -0,0 +1,27 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <ostream>
+#include <streambuf>
+#include <vector>
+#include "../include/regular_polygon.h"
+
+// Output sink for the print_* benchmarks: formatting is measured, writing is not.
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        return n;
+    }
+};
+
+template <Scalar T, int V>
+inline std::vector<Point<T>> bench_polygon_points(size_t i) {
+    return gen_regular_polygon_points<T>(V, static_cast<T>(i % 1000), static_cast<T>(i % 777), static_cast<T>(i % 13) / 10, 1 + static_cast<T>(i % 100));
+}
+
+#endif
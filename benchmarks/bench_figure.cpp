@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include "../include/regular_polygon.h"
+#include "./bench.h"
+#include <sstream>
+#include <iomanip>
+#include <string>
+
+template <Scalar T, int V>
+static void BM_RegularPolygonConstruct(benchmark::State& state) {
+    std::vector<Point<T>> points = bench_polygon_points<T, V>(7);
+    for (auto _ : state) {
+        RegularPolygon<T, V> figure(points);
+        benchmark::DoNotOptimize(figure);
+    }
+}
+BENCHMARK_TEMPLATE(BM_RegularPolygonConstruct, float, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonConstruct, float, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonConstruct, float, 8);
+BENCHMARK_TEMPLATE(BM_RegularPolygonConstruct, double, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonConstruct, double, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonConstruct, double, 8);
+
+template <Scalar T, int V>
+static void BM_RegularPolygonValidate(benchmark::State& state) {
+    std::vector<Point<T>> points = bench_polygon_points<T, V>(7);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(regular_polygon_invalid<T, V>(points.data()));
+    }
+}
+BENCHMARK_TEMPLATE(BM_RegularPolygonValidate, float, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonValidate, float, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonValidate, float, 8);
+BENCHMARK_TEMPLATE(BM_RegularPolygonValidate, double, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonValidate, double, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonValidate, double, 8);
+
+// Construction through operator>> runs the full regular polygon validation.
+template <Scalar T, int V>
+static void BM_RegularPolygonRead(benchmark::State& state) {
+    std::stringstream ss;
+    ss << std::setprecision(17);
+    for (const auto &p : bench_polygon_points<T, V>(7)) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    const std::string text = ss.str();
+    RegularPolygon<T, V> figure;
+    for (auto _ : state) {
+        std::stringstream is(text);
+        is >> figure;
+        benchmark::DoNotOptimize(figure);
+    }
+}
+BENCHMARK_TEMPLATE(BM_RegularPolygonRead, float, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonRead, float, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonRead, float, 8);
+BENCHMARK_TEMPLATE(BM_RegularPolygonRead, double, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonRead, double, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonRead, double, 8);
+
+template <Scalar T, int V>
+static void BM_RegularPolygonCopy(benchmark::State& state) {
+    RegularPolygon<T, V> figure(bench_polygon_points<T, V>(7));
+    for (auto _ : state) {
+        RegularPolygon<T, V> copy(figure);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK_TEMPLATE(BM_RegularPolygonCopy, float, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonCopy, float, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonCopy, float, 8);
+BENCHMARK_TEMPLATE(BM_RegularPolygonCopy, double, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonCopy, double, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonCopy, double, 8);
+
+template <Scalar T, int V>
+static void BM_RegularPolygonMove(benchmark::State& state) {
+    RegularPolygon<T, V> figure(bench_polygon_points<T, V>(7));
+    for (auto _ : state) {
+        RegularPolygon<T, V> moved(std::move(figure));
+        figure = std::move(moved);
+        benchmark::DoNotOptimize(figure);
+    }
+}
+BENCHMARK_TEMPLATE(BM_RegularPolygonMove, float, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonMove, float, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonMove, float, 8);
+BENCHMARK_TEMPLATE(BM_RegularPolygonMove, double, 3);
+BENCHMARK_TEMPLATE(BM_RegularPolygonMove, double, 6);
+BENCHMARK_TEMPLATE(BM_RegularPolygonMove, double, 8);
+
+template <Scalar T, int V>
+static void BM_GenRegularPolygonPoints(benchmark::State& state) {
+    size_t i{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bench_polygon_points<T, V>(i++));
+    }
+}
+BENCHMARK_TEMPLATE(BM_GenRegularPolygonPoints, double, 6);
+BENCHMARK_TEMPLATE(BM_GenRegularPolygonPoints, double, 8);
+
+// Unit table path: one sin/cos pair per polygon and no allocation.
+template <Scalar T, int V>
+static void BM_GenRegularPolygonPointsTable(benchmark::State& state) {
+    size_t i{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gen_regular_polygon_points<T, V>(static_cast<T>(i % 1000), static_cast<T>(i % 777),
+                static_cast<T>(i % 13) / 10, 1 + static_cast<T>(i % 100)));
+        ++i;
+    }
+}
+BENCHMARK_TEMPLATE(BM_GenRegularPolygonPointsTable, double, 6);
+BENCHMARK_TEMPLATE(BM_GenRegularPolygonPointsTable, double, 8);
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+#include "../include/regular_polygon.h"
+#include "../include/my_array.h"
+#include "./bench.h"
+#include <ostream>
+
+template <Scalar T, int V>
+static MyArray<RegularPolygon<T, V>> make_array(size_t n) {
+    MyArray<RegularPolygon<T, V>> arr(0);
+    arr.reserve(n);
+    for (size_t i{0}; i < n; ++i) {
+        arr.emplace_back(bench_polygon_points<T, V>(i));
+    }
+    return arr;
+}
+
+static void array_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(100, 10'000'000)->Unit(benchmark::kMicrosecond);
+}
+
+template <Scalar T, int V>
+static void BM_MyArrayTotalSquare(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arr.total_square());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MyArrayTotalSquare, float, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayTotalSquare, double, 3)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayTotalSquare, double, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayTotalSquare, double, 8)->Apply(array_sizes);
+
+template <Scalar T, int V>
+static void BM_MyArrayTotalSquareParallel(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arr.total_square(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MyArrayTotalSquareParallel, float, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayTotalSquareParallel, double, 6)->Apply(array_sizes);
+
+// Removes from the middle and appends one figure back, so the size stays fixed.
+template <Scalar T, int V>
+static void BM_MyArrayRemove(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    RegularPolygon<T, V> figure(bench_polygon_points<T, V>(1));
+    for (auto _ : state) {
+        arr.remove(arr.size() / 2);
+        arr.push_back(figure);
+    }
+}
+BENCHMARK_TEMPLATE(BM_MyArrayRemove, float, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayRemove, double, 6)->Apply(array_sizes);
+
+template <Scalar T, int V>
+static void BM_MyArrayPrint(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    NullBuffer buffer;
+    std::ostream os(&buffer);
+    for (auto _ : state) {
+        arr.print(os);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MyArrayPrint, float, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayPrint, double, 6)->Apply(array_sizes);
+
+template <Scalar T, int V>
+static void BM_MyArrayPrintCentres(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    NullBuffer buffer;
+    std::ostream os(&buffer);
+    for (auto _ : state) {
+        arr.print_centres(os);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MyArrayPrintCentres, float, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayPrintCentres, double, 6)->Apply(array_sizes);
+
+template <Scalar T, int V>
+static void BM_MyArrayPrintSquares(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    NullBuffer buffer;
+    std::ostream os(&buffer);
+    for (auto _ : state) {
+        arr.print_squares(os);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MyArrayPrintSquares, float, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayPrintSquares, double, 6)->Apply(array_sizes);
+
+template <Scalar T, int V>
+static void BM_MyArrayRotate(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    for (auto _ : state) {
+        arr.rotate(static_cast<T>(0.01), Point<T>(500, 500));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MyArrayRotate, float, 6)->Apply(array_sizes);
+BENCHMARK_TEMPLATE(BM_MyArrayRotate, double, 6)->Apply(array_sizes);
+
+template <Scalar T, int V>
+static void BM_MyArrayTopKByArea(benchmark::State& state) {
+    MyArray<RegularPolygon<T, V>> arr = make_array<T, V>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arr.top_k_by_area(1000, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MyArrayTopKByArea, double, 6)->Apply(array_sizes);
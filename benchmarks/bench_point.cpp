@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include "../include/point.h"
+#include "../include/point_batch.h"
+#include "./bench.h"
+#include <vector>
+
+template <Scalar T>
+static void BM_PointRotate(benchmark::State& state) {
+    Point<T> p(T(1.5), T(-2.5));
+    T angle{T(0.3)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.rotate(angle));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_PointRotate, float);
+BENCHMARK_TEMPLATE(BM_PointRotate, double);
+
+template <Scalar T>
+static void BM_PointLength(benchmark::State& state) {
+    Point<T> p(T(1.5), T(-2.5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.length());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_PointLength, float);
+BENCHMARK_TEMPLATE(BM_PointLength, double);
+
+template <Scalar T>
+static void BM_PointAngleTo(benchmark::State& state) {
+    Point<T> p1(T(1.5), T(-2.5));
+    Point<T> p2(T(-0.5), T(4));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p1.angle_to(p2));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_PointAngleTo, float);
+BENCHMARK_TEMPLATE(BM_PointAngleTo, double);
+
+template <Scalar T>
+static void BM_PointBatchRotate(benchmark::State& state) {
+    std::vector<Point<T>> points(state.range(0), Point<T>(T(1.5), T(-2.5)));
+    for (auto _ : state) {
+        batch_rotate<T>(points, T(0.3));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_PointBatchRotate, float)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK_TEMPLATE(BM_PointBatchRotate, double)->RangeMultiplier(10)->Range(100, 1'000'000);
+
+template <Scalar T>
+static void BM_PointBatchLength(benchmark::State& state) {
+    std::vector<Point<T>> points(state.range(0), Point<T>(T(1.5), T(-2.5)));
+    std::vector<T> lengths(points.size());
+    for (auto _ : state) {
+        batch_length<T>(points, lengths);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_PointBatchLength, float)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK_TEMPLATE(BM_PointBatchLength, double)->RangeMultiplier(10)->Range(100, 1'000'000);
@@ -0,0 +1,104 @@
+#ifndef BOUNDING_BOX_H
+#define BOUNDING_BOX_H
+
+#include "./point.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <limits>
+
+// Axis-aligned bounding box, closed on all sides.
+template<Scalar T>
+class BoundingBox final
+{
+    template<Scalar A>
+    friend std::ostream& operator<<(std::ostream& os, const BoundingBox<A>& obj);
+
+private:
+    Point<T> _min;
+    Point<T> _max;
+
+public:
+    BoundingBox() = default;
+
+    BoundingBox(const Point<T>& min, const Point<T>& max) :
+        _min(min), _max(max)
+    {
+        if (min.get_x() > max.get_x() || min.get_y() > max.get_y()) {
+            throw std::invalid_argument("Bounding box minimum exceeds maximum");
+        }
+    }
+
+    // Box of no points: contains nothing and intersects nothing.
+    static BoundingBox<T> empty() {
+        BoundingBox<T> box;
+        box._min = Point<T>(std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity());
+        box._max = Point<T>(-std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity());
+        return box;
+    }
+
+    static BoundingBox<T> from_points(const Point<T>* points, size_t count) {
+        if (count == 0) {
+            return empty();
+        }
+        T min_x = points[0].get_x();
+        T min_y = points[0].get_y();
+        T max_x = min_x;
+        T max_y = min_y;
+        for (size_t i{1}; i < count; ++i) {
+            min_x = std::min(min_x, points[i].get_x());
+            min_y = std::min(min_y, points[i].get_y());
+            max_x = std::max(max_x, points[i].get_x());
+            max_y = std::max(max_y, points[i].get_y());
+        }
+        BoundingBox<T> box;
+        box._min = Point<T>(min_x, min_y);
+        box._max = Point<T>(max_x, max_y);
+        return box;
+    }
+
+public:
+    Point<T> get_min() const {
+        return _min;
+    }
+
+    Point<T> get_max() const {
+        return _max;
+    }
+
+    bool contains(const Point<T>& p) const {
+        return p.get_x() >= _min.get_x() && p.get_x() <= _max.get_x() &&
+               p.get_y() >= _min.get_y() && p.get_y() <= _max.get_y();
+    }
+
+    // Same as contains(p) for the box grown by margin on every side.
+    bool contains(const Point<T>& p, T margin) const {
+        return p.get_x() >= _min.get_x() - margin && p.get_x() <= _max.get_x() + margin &&
+               p.get_y() >= _min.get_y() - margin && p.get_y() <= _max.get_y() + margin;
+    }
+
+    bool contains(const BoundingBox<T>& other) const {
+        return contains(other._min) && contains(other._max);
+    }
+
+    bool intersects(const BoundingBox<T>& other) const {
+        return _min.get_x() <= other._max.get_x() && other._min.get_x() <= _max.get_x() &&
+               _min.get_y() <= other._max.get_y() && other._min.get_y() <= _max.get_y();
+    }
+
+    bool operator==(const BoundingBox<T>& other) const {
+        return _min == other._min && _max == other._max;
+    }
+
+    bool operator!=(const BoundingBox<T>& other) const {
+        return !(*this == other);
+    }
+};
+
+template<Scalar T>
+std::ostream& operator<<(std::ostream& os, const BoundingBox<T>& obj) {
+    os << "[ " << obj._min << ", " << obj._max << " ]";
+    return os;
+}
+
+#endif
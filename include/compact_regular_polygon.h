@@ -0,0 +1,285 @@
+#ifndef COMPACT_REGULAR_POLYGON_H
+#define COMPACT_REGULAR_POLYGON_H
+
+#include "./regular_polygon.h"
+#include "./inline_regular_polygon.h"
+#include "./bounding_box.h"
+#include "./instrumentation.h"
+#include <array>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <iostream>
+#include <initializer_list>
+#include <exception>
+#include <vector>
+
+// Regular polygon stored as its centre and the vector from the centre to the first
+// vertex, that is the circumradius and the phase in cartesian form. Four scalars
+// whatever V is. Vertices are generated on access by rotating that vector clockwise
+// with the compile-time regular_polygon_unit_circle table, metrics are closed form.
+template <Scalar T, int V>
+class CompactRegularPolygon final
+{
+    static_assert(V >= 3, "There are too few vertices");
+
+    template<Scalar A, int B>
+    friend std::ostream& operator<<(std::ostream& os, const CompactRegularPolygon<A, B>& obj);
+
+    template<Scalar A, int B>
+    friend std::istream& operator>>(std::istream& is, CompactRegularPolygon<A, B>& obj);
+
+    // For apply_similarity.
+    template<typename A>
+    requires IsFigure<A> || (std::is_pointer_v<A> && IsFigure<std::remove_pointer_t<A>>)
+    friend class MyArray;
+
+public:
+    using value_type = T;
+    static constexpr int vertices_number = V;
+
+private:
+    Point<T> _centre;
+    Point<T> _radius;
+
+public:
+    CompactRegularPolygon() {
+        std::vector<Point<T>> points = gen_regular_polygon_points<T>(V, 0, 0, 0, 1);
+        set_points(points.data(), points.size());
+    }
+
+    // phase is the angle of the first vertex as seen from the centre.
+    CompactRegularPolygon(const Point<T>& centre, T circumradius, T phase) :
+        _centre(centre),
+        _radius(circumradius * std::cos(phase), circumradius * std::sin(phase))
+    {
+        if (!std::isfinite(centre.get_x()) || !std::isfinite(centre.get_y())) {
+            throw std::invalid_argument("Centre must be finite");
+        }
+        if (!(circumradius >= Point<T>::eps && std::isfinite(circumradius))) {
+            throw std::invalid_argument("Circumradius must be positive and finite");
+        }
+        if (!std::isfinite(phase)) {
+            throw std::invalid_argument("Phase must be finite");
+        }
+    }
+
+    CompactRegularPolygon(const std::vector<Point<T>>& points) {
+        set_points(points.data(), points.size());
+    }
+
+    CompactRegularPolygon(const std::initializer_list<Point<T>>& points) {
+        set_points(points.begin(), points.size());
+    }
+
+    CompactRegularPolygon(std::span<const Point<T>, V> points) {
+        set_points(points.data(), points.size());
+    }
+
+    explicit CompactRegularPolygon(const RegularPolygon<T, V>& other) :
+        _centre(other.calc_centre()),
+        _radius(other[0] - _centre)
+    {}
+
+    explicit CompactRegularPolygon(const InlineRegularPolygon<T, V>& other) :
+        _centre(other.calc_centre()),
+        _radius(other[0] - _centre)
+    {}
+
+    CompactRegularPolygon(const CompactRegularPolygon<T, V>& other) = default;
+
+    CompactRegularPolygon(CompactRegularPolygon<T, V>&& other) noexcept = default;
+
+    CompactRegularPolygon<T, V>& operator=(const CompactRegularPolygon<T, V>& other) = default;
+
+    CompactRegularPolygon<T, V>& operator=(CompactRegularPolygon<T, V>&& other) noexcept = default;
+
+    ~CompactRegularPolygon() noexcept = default;
+
+public:
+    // Non-throwing factory: returns nothing if the points do not form a valid polygon.
+    static std::optional<CompactRegularPolygon<T, V>> make(std::span<const Point<T>, V> points) {
+        if (regular_polygon_invalid<T, V>(points.data())) {
+            return std::nullopt;
+        }
+        CompactRegularPolygon<T, V> figure(points.data());
+        return figure;
+    }
+
+public:
+    int get_vertices_number() const {
+        return V;
+    }
+
+    Point<T> get_centre() const {
+        return _centre;
+    }
+
+    T get_circumradius() const {
+        return _radius.length();
+    }
+
+    T get_phase() const {
+        return std::atan2(_radius.get_y(), _radius.get_x());
+    }
+
+    Point<T> operator[](int point_index) const {
+        if (point_index < 0 || point_index >= V) {
+            throw std::out_of_range("Point index is out of range");
+        }
+        return vertex(point_index);
+    }
+
+    std::array<Point<T>, V> get_points() const {
+        std::array<Point<T>, V> points;
+        for (int i{0}; i < V; ++i) {
+            points[i] = vertex(i);
+        }
+        return points;
+    }
+
+    BoundingBox<T> get_bounding_box() const {
+        std::array<Point<T>, V> points = get_points();
+        return BoundingBox<T>::from_points(points.data(), V);
+    }
+
+    Point<T> calc_centre() const {
+        return _centre;
+    }
+
+    explicit operator T() const {
+        return square();
+    }
+
+    bool contains(const Point<T>& point) const {
+        std::array<Point<T>, V> points = get_points();
+        return convex_polygon_contains(points.data(), V, point);
+    }
+
+    void contains(std::span<const Point<T>> points, std::span<bool> result) const {
+        std::array<Point<T>, V> vertices = get_points();
+        convex_polygon_contains(vertices.data(), V, points, result);
+    }
+
+    bool operator==(const CompactRegularPolygon<T, V>& other) const {
+        return std::abs(side_length() - other.side_length()) < Point<T>::eps;
+    }
+
+    bool operator!=(const CompactRegularPolygon<T, V>& other) const {
+        return !(*this == other);
+    }
+
+public:
+    // 2 R sin(pi / V)
+    T side_length() const {
+        const auto &[c, s] = regular_polygon_unit_circle<T, V>[1];
+        return _radius.length() * std::sqrt(2 * (1 - c));
+    }
+
+    // Same formula as RegularPolygon, so both representations report the same value.
+    T square() const {
+        return regular_polygon_square<T>(V, side_length());
+    }
+
+public:
+    // Closed-form similarity transforms, see Figure::translate, rotate and scale.
+    void translate(const Point<T>& offset) {
+        check_similarity(1, 0, offset);
+        _centre += offset;
+    }
+
+    void rotate(T angle, const Point<T>& pivot = Point<T>()) {
+        const T c = std::cos(angle);
+        const T s = std::sin(angle);
+        const Point<T> offset = similarity_offset(c, s, pivot);
+        check_similarity(c, s, offset);
+        apply_similarity(c, s, offset);
+    }
+
+    void scale(T k, const Point<T>& pivot = Point<T>()) {
+        if (std::abs(k) < Point<T>::eps) {
+            throw std::invalid_argument("Scale factor must not be zero");
+        }
+        check_similarity(k, 0, pivot * (1 - k));
+        _centre = pivot + (_centre - pivot) * k;
+        _radius *= k;
+    }
+
+private:
+    static void check_similarity(T c, T s, const Point<T>& offset) {
+        if (similarity_invalid(c, s, offset)) {
+            throw std::invalid_argument("Invalid similarity transform");
+        }
+    }
+
+    // p -> (c -s; s c) * p + offset, see Figure::apply_similarity.
+    void apply_similarity(T c, T s, const Point<T>& offset) {
+        _centre = Point<T>(c * _centre.get_x() - s * _centre.get_y(), s * _centre.get_x() + c * _centre.get_y()) + offset;
+        _radius = Point<T>(c * _radius.get_x() - s * _radius.get_y(), s * _radius.get_x() + c * _radius.get_y());
+    }
+
+    // Points are validated by the caller.
+    explicit CompactRegularPolygon(const Point<T>* points) {
+        assign_points(points);
+    }
+
+    // The radius vector turned clockwise by 2*pi*index/V.
+    Point<T> vertex(int index) const {
+        const auto &[c, s] = regular_polygon_unit_circle<T, V>[index];
+        return _centre + Point<T>(_radius.get_x() * c + _radius.get_y() * s, _radius.get_y() * c - _radius.get_x() * s);
+    }
+
+    void print(std::ostream& os) const {
+        FIGURE_COUNT(records_written);
+        print_regular_polygon_name(os, V);
+        os << "[ ";
+        for (int i{0}; i < V - 1; ++i) {
+            os << vertex(i) << ", ";
+        }
+        os << vertex(V - 1) << " ]";
+    }
+
+    void read(std::istream& is) {
+        FIGURE_TIME(read);
+        FIGURE_COUNT(records_read);
+        std::array<Point<T>, V> points;
+        for (auto &p : points) {
+            is >> p;
+        }
+        set_points(points.data(), points.size());
+    }
+
+    void set_points(const Point<T>* points, size_t count) {
+        if (count != V) {
+            throw std::invalid_argument("Invalid vertices number");
+        }
+        if (regular_polygon_invalid<T, V>(points)) {
+            FIGURE_COUNT(validation_rejects);
+            throw std::invalid_argument("Invalid sides");
+        }
+        assign_points(points);
+    }
+
+    void assign_points(const Point<T>* points) {
+        Point<T> summ;
+        for (int i{0}; i < V; ++i) {
+            summ += points[i];
+        }
+        _centre = summ / V;
+        _radius = points[0] - _centre;
+    }
+};
+
+template<Scalar T, int V>
+std::ostream& operator<<(std::ostream& os, const CompactRegularPolygon<T, V>& obj) {
+    obj.print(os);
+    return os;
+}
+
+template<Scalar T, int V>
+std::istream& operator>>(std::istream& is, CompactRegularPolygon<T, V>& obj) {
+    obj.read(is);
+    return is;
+}
+
+#endif
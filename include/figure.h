@@ -2,15 +2,101 @@
 #define FIGURE_H
 
 #include "./point.h"
+#include "./bounding_box.h"
+#include "./point_batch.h"
+#include "./instrumentation.h"
+#include "./metric_cache.h"
+#include "./my_array_fwd.h"
+#include <cmath>
 #include <iostream>
 #include <initializer_list>
 #include <exception>
 #include <string>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <algorithm>
 #include <vector>
 #include <type_traits>
 #include <concepts>
 
+// At least 3 vertices, finite and going clockwise with no degenerate edges or straight angles.
+// Both tests are relative, so the rule does not depend on the figure size: the cross
+// product must be below -eps * |v1| * |v2|, i.e. the turn sine below -eps, and no edge
+// may be shorter than eps times its neighbour. Squared lengths avoid a sqrt per edge.
+// The conditions are written as what a valid figure satisfies, so NaN fails them.
+template<Scalar T>
+bool convex_polygon_invalid(const Point<T>* points, size_t count) {
+    if (count < 3) {
+        return true;
+    }
+    const T eps2 = Point<T>::eps * Point<T>::eps;
+    Point<T> v1 = points[1 % count] - points[0];
+    for (size_t i{0}; i < count; ++i) {
+        const Point<T> &p = points[(i + 1) % count];
+        if (!std::isfinite(p.get_x()) || !std::isfinite(p.get_y())) {
+            return true;
+        }
+        Point<T> v2 = points[(i + 2) % count] - p;
+        const T cross = vector_product_factor(v1, v2);
+        const T length1 = scalar_product(v1, v1);
+        const T length2 = scalar_product(v2, v2);
+        if (!(cross < 0 && cross * cross >= eps2 * length1 * length2 && length2 >= eps2 * length1)) {
+            return true;
+        }
+        v1 = v2;
+    }
+    return false;
+}
+
+// Point-in-polygon for valid (convex, clockwise) figures: a point is inside when it is in
+// the figure's bounding box grown by eps and not to the left of any edge by more than eps.
+// So points on the boundary, up to eps, count as inside, and the box test both culls far
+// points and keeps the edge tolerance from reaching past sharp vertices.
+// Edges are the outer loop, so the inner loop over points is branch-free and vectorizable.
+template<Scalar T>
+void convex_polygon_contains(const Point<T>* vertices, size_t count, const BoundingBox<T>& box,
+        std::span<const Point<T>> points, std::span<bool> result) {
+    if (points.size() != result.size()) {
+        throw std::invalid_argument("Batch sizes do not match");
+    }
+    for (size_t j{0}; j < points.size(); ++j) {
+        result[j] = box.contains(points[j], Point<T>::eps);
+    }
+    for (size_t i{0}; i < count; ++i) {
+        const Point<T> v = vertices[i];
+        const Point<T> edge = vertices[(i + 1) % count] - v;
+        const T ex = edge.get_x();
+        const T ey = edge.get_y();
+        const T tolerance = Point<T>::eps * edge.length();
+        for (size_t j{0}; j < points.size(); ++j) {
+            const T cross = ex * (points[j].get_y() - v.get_y()) - ey * (points[j].get_x() - v.get_x());
+            result[j] = result[j] & (cross <= tolerance);
+        }
+    }
+}
+
+template<Scalar T>
+bool convex_polygon_contains(const Point<T>* vertices, size_t count, const BoundingBox<T>& box, const Point<T>& point) {
+    if (!box.contains(point, Point<T>::eps)) {
+        return false;
+    }
+    bool inside;
+    convex_polygon_contains(vertices, count, box, std::span<const Point<T>>(&point, 1), std::span<bool>(&inside, 1));
+    return inside;
+}
+
+// For callers without a stored bounding box.
+template<Scalar T>
+void convex_polygon_contains(const Point<T>* vertices, size_t count, std::span<const Point<T>> points, std::span<bool> result) {
+    convex_polygon_contains(vertices, count, BoundingBox<T>::from_points(vertices, count), points, result);
+}
+
+template<Scalar T>
+bool convex_polygon_contains(const Point<T>* vertices, size_t count, const Point<T>& point) {
+    return convex_polygon_contains(vertices, count, BoundingBox<T>::from_points(vertices, count), point);
+}
+
 template<Scalar T>
 class Figure
 {    
@@ -20,43 +106,108 @@ class Figure
     template<Scalar A>
     friend std::istream& operator>>(std::istream& is, Figure<A>& obj);
 
+    // For apply_similarity.
+    template<typename A>
+    requires IsFigure<A> || (std::is_pointer_v<A> && IsFigure<std::remove_pointer_t<A>>)
+    friend class MyArray;
+
 public:
     using value_type = T;
+    using allocator_type = std::pmr::polymorphic_allocator<Point<T>>;
+
+protected:
+    // Vertex buffers come from a memory resource, so figures can be carved
+    // from a monotonic or pooled arena and released together with it.
+    struct PointsDeleter {
+        std::pmr::memory_resource* resource{std::pmr::get_default_resource()};
+        size_t count{0};
+
+        void operator()(Point<T>* points) const {
+            resource->deallocate(points, count * sizeof(Point<T>), alignof(Point<T>));
+        }
+    };
+
+    using points_ptr = std::unique_ptr<Point<T>[], PointsDeleter>;
 
 protected:
     int _vertices_number;
-    std::unique_ptr<Point<T>[]> _points;
+    points_ptr _points;
+    BoundingBox<T> _bounding_box;
+
+    // Metrics cache, filled lazily and reset whenever the vertices change. Safe to fill
+    // from several readers at once, see MetricCache.
+    bool _metrics_caching{false};
+    mutable MetricCache<T> _square_cache;
+    mutable MetricCache<Point<T>> _centre_cache;
 
 public:
     int get_vertices_number() const {
         return _vertices_number;
     }
 
+    // Kept up to date by set_points, so reading it costs nothing.
+    const BoundingBox<T>& get_bounding_box() const {
+        return _bounding_box;
+    }
+
+    bool get_metrics_caching() const {
+        return _metrics_caching;
+    }
+
+    void set_metrics_caching(bool enabled) {
+        _metrics_caching = enabled;
+        invalidate_metrics();
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(_points.get_deleter().resource);
+    }
+
 protected:
-    Figure(const std::vector<Point<T>>& points) :
+    Figure(const std::vector<Point<T>>& points, const allocator_type& allocator = {}) :
         _vertices_number(points.size()),
-        _points(std::make_unique<Point<T>[]>(points.size()))
+        _points(allocate_points(points.size(), allocator))
     {
+        FIGURE_TIME(construction);
         if (points.size() < 3) {
             throw std::invalid_argument("There are too few vertices");
         }
         set_points(points);
     }
 
-    Figure(const std::initializer_list<Point<T>>& points) :
+    Figure(const std::initializer_list<Point<T>>& points, const allocator_type& allocator = {}) :
         _vertices_number(points.size()),
-        _points(std::make_unique<Point<T>[]>(points.size()))
+        _points(allocate_points(points.size(), allocator))
     {
+        FIGURE_TIME(construction);
         if (points.size() < 3) {
             throw std::invalid_argument("There are too few vertices");
         }
         set_points(std::vector<Point<T>>(points));
     }
 
-    Figure(const Figure<T>& other) :
+    // For derived figures that have already checked the points against their own rule,
+    // which must include the convex check, so the points are validated only once.
+    struct validated_points_tag {};
+
+    Figure(validated_points_tag, const Point<T>* points, size_t count, const allocator_type& allocator = {}) :
+        _vertices_number(count),
+        _points(allocate_points(count, allocator)),
+        _bounding_box(BoundingBox<T>::from_points(points, count))
+    {
+        FIGURE_TIME(construction);
+        std::copy_n(points, count, _points.get());
+    }
+
+    Figure(const Figure<T>& other, const allocator_type& allocator = {}) :
         _vertices_number(other._vertices_number),
-        _points(std::make_unique<Point<T>[]>(other._vertices_number))
+        _points(allocate_points(other._vertices_number, allocator)),
+        _bounding_box(other._bounding_box),
+        _metrics_caching(other._metrics_caching),
+        _square_cache(other._square_cache),
+        _centre_cache(other._centre_cache)
     {
+        FIGURE_COUNT(figure_copies);
         for (size_t i{0}; i < static_cast<size_t>(other._vertices_number); ++i) {
             _points[i] = other._points[i];
         }
@@ -64,29 +215,60 @@ protected:
 
     Figure(Figure<T>&& other) noexcept :
         _vertices_number(other._vertices_number),
-        _points(std::move(other._points))
+        _points(std::move(other._points)),
+        _bounding_box(other._bounding_box),
+        _metrics_caching(other._metrics_caching),
+        _square_cache(other._square_cache),
+        _centre_cache(other._centre_cache)
     {
+        FIGURE_COUNT(figure_moves);
         other._vertices_number = 0;
+        other._bounding_box = BoundingBox<T>::empty();
+        other.invalidate_metrics();
+    }
+
+    // Steals the vertices when both figures use the same resource, copies them otherwise.
+    Figure(Figure<T>&& other, const allocator_type& allocator) :
+        _vertices_number(other._vertices_number),
+        _points(other.get_allocator() == allocator ?
+                std::move(other._points) : allocate_points(other._vertices_number, allocator)),
+        _bounding_box(other._bounding_box),
+        _metrics_caching(other._metrics_caching),
+        _square_cache(other._square_cache),
+        _centre_cache(other._centre_cache)
+    {
+        if (other._points) {
+            FIGURE_COUNT(figure_copies);
+            for (size_t i{0}; i < static_cast<size_t>(other._vertices_number); ++i) {
+                _points[i] = other._points[i];
+            }
+        } else {
+            FIGURE_COUNT(figure_moves);
+            other._vertices_number = 0;
+            other._bounding_box = BoundingBox<T>::empty();
+            other.invalidate_metrics();
+        }
     }
 
 public:
     virtual Figure<T>& operator=(const Figure<T>& other) {
         if (this != &other) {
+            FIGURE_COUNT(figure_copies);
             _vertices_number = other._vertices_number;
-            _points = std::make_unique<Point<T>[]>(other._vertices_number);
+            _points = allocate_points(other._vertices_number, get_allocator());
             for (size_t i{0}; i < static_cast<size_t>(other._vertices_number); ++i) {
                 _points[i] = other._points[i];
             }
+            _bounding_box = other._bounding_box;
+            _metrics_caching = other._metrics_caching;
+            invalidate_metrics();
         }
         return *this;
     }
 
-    Figure<T>& operator=(Figure<T>&& other) noexcept {
-        if (this != &other) {
-            _vertices_number = other._vertices_number;
-            _points = std::move(other._points);
-            other._vertices_number = 0;
-        }
+    // Keeps this figure's resource, see move_assign.
+    Figure<T>& operator=(Figure<T>&& other) {
+        move_assign(other);
         return *this;
     }
 
@@ -103,15 +285,17 @@ public:
 
 public:
     Point<T> calc_centre() const {
-        Point<T> summ;
-        for (size_t i{0}; i < static_cast<size_t>(_vertices_number); ++i) {
-            summ += _points[i];
+        if (!_metrics_caching) {
+            return compute_centre();
         }
-        return summ / _vertices_number;
+        return _centre_cache.get([this] { return compute_centre(); });
     }
 
     explicit operator T() const {
-        return square();
+        if (!_metrics_caching) {
+            return square();
+        }
+        return _square_cache.get([this] { return square(); });
     }
 
 public:
@@ -121,14 +305,111 @@ public:
         return !(*this == other);
     }
 
+public:
+    bool contains(const Point<T>& point) const {
+        return convex_polygon_contains(_points.get(), _vertices_number, _bounding_box, point);
+    }
+
+    // result[i] = contains(points[i])
+    void contains(std::span<const Point<T>> points, std::span<bool> result) const {
+        convex_polygon_contains(_points.get(), _vertices_number, _bounding_box, points, result);
+    }
+
+public:
+    // Similarity transforms keep the figure regular and clockwise, so they are applied
+    // in place without revalidation. Non-finite arguments are rejected and leave the
+    // figure unchanged.
+    void translate(const Point<T>& offset) {
+        checked_similarity(1, 0, offset);
+    }
+
+    // Clockwise order is kept because rotation preserves orientation.
+    void rotate(T angle, const Point<T>& pivot = Point<T>()) {
+        const T c = std::cos(angle);
+        const T s = std::sin(angle);
+        checked_similarity(c, s, similarity_offset(c, s, pivot));
+    }
+
+    // A negative factor is a rotation by pi combined with scaling, so it is allowed too.
+    void scale(T k, const Point<T>& pivot = Point<T>()) {
+        if (std::abs(k) < Point<T>::eps) {
+            throw std::invalid_argument("Scale factor must not be zero");
+        }
+        checked_similarity(k, 0, pivot * (1 - k));
+    }
+
+    // p -> (a b; c d) * p + offset. The result is validated like any new points and the
+    // figure is left unchanged if it is not valid.
+    void transform(T a, T b, T c, T d, const Point<T>& offset) {
+        std::vector<Point<T>> points(_points.get(), _points.get() + _vertices_number);
+        batch_affine<T>(points, a, b, c, d, offset);
+        set_points(points);
+    }
+
+private:
+    void checked_similarity(T c, T s, const Point<T>& offset) {
+        if (similarity_invalid(c, s, offset)) {
+            throw std::invalid_argument("Invalid similarity transform");
+        }
+        apply_similarity(c, s, offset);
+    }
+
+    // p -> (c -s; s c) * p + offset, the rotation by atan2(s, c) scaled by |(c, s)| the
+    // transforms above reduce to. Unchecked: MyArray::rotate validates c, s and offset
+    // once and then moves many figures by them.
+    void apply_similarity(T c, T s, const Point<T>& offset) {
+        batch_affine<T>(std::span<Point<T>>(_points.get(), _vertices_number), c, -s, s, c, offset);
+        _bounding_box = BoundingBox<T>::from_points(_points.get(), _vertices_number);
+        invalidate_metrics();
+    }
+
 protected:
-    void set_points(const std::vector<Point<T>>& points) noexcept(false) {
-        if (sides_invalid(points)) {
-            std::string s;
-            for (size_t i = 0; i < points.size(); ++i) {
-                s += points[i].str();
+    // Allocators do not propagate on assignment: the vertices are stolen only if both
+    // figures use the same resource, otherwise they are copied into this figure's one
+    // and other is left as it is, like the allocator-extended move constructor does.
+    void move_assign(Figure<T>& other) {
+        if (this == &other) {
+            return;
+        }
+        if (get_allocator() == other.get_allocator()) {
+            FIGURE_COUNT(figure_moves);
+            _points = std::move(other._points);
+        } else {
+            FIGURE_COUNT(figure_copies);
+            points_ptr points = allocate_points(other._vertices_number, get_allocator());
+            for (size_t i{0}; i < static_cast<size_t>(other._vertices_number); ++i) {
+                points[i] = other._points[i];
             }
-            throw std::invalid_argument("Invalid sides. Points: " + s);
+            _points = std::move(points);
+        }
+        _vertices_number = other._vertices_number;
+        _bounding_box = other._bounding_box;
+        _metrics_caching = other._metrics_caching;
+        invalidate_metrics();
+        if (!other._points) {
+            other._vertices_number = 0;
+            other._bounding_box = BoundingBox<T>::empty();
+            other.invalidate_metrics();
+        }
+    }
+
+    static points_ptr allocate_points(size_t count, const allocator_type& allocator) {
+        FIGURE_COUNT(point_allocations);
+        std::pmr::memory_resource *resource = allocator.resource();
+        Point<T> *points = static_cast<Point<T>*>(resource->allocate(count * sizeof(Point<T>), alignof(Point<T>)));
+        std::uninitialized_default_construct_n(points, count);
+        return points_ptr(points, PointsDeleter{resource, count});
+    }
+
+    void set_points(const std::vector<Point<T>>& points) noexcept(false) {
+        bool invalid;
+        {
+            FIGURE_TIME(validation);
+            invalid = sides_invalid(points);
+        }
+        if (invalid) {
+            FIGURE_COUNT(validation_rejects);
+            throw std::invalid_argument("Invalid sides");
         }
         if (points.size() != _vertices_number) {
             throw std::invalid_argument("Number of vertices does not match the existing one");
@@ -138,9 +419,25 @@ protected:
             _points[ind] = p;
             ++ind;
         }
+        _bounding_box = BoundingBox<T>::from_points(_points.get(), _vertices_number);
+        invalidate_metrics();
+    }
+
+    Point<T> compute_centre() const {
+        Point<T> summ;
+        for (size_t i{0}; i < static_cast<size_t>(_vertices_number); ++i) {
+            summ += _points[i];
+        }
+        return summ / _vertices_number;
+    }
+
+    virtual void invalidate_metrics() const {
+        _square_cache.reset();
+        _centre_cache.reset();
     }
 
     virtual void print(std::ostream& os) const {
+        FIGURE_COUNT(records_written);
         os << "[ ";
         for (size_t i{0}; i < static_cast<size_t>(_vertices_number) - 1; ++i) {
             os << _points[i] << ", ";
@@ -149,6 +446,8 @@ protected:
     }
 
     virtual void read(std::istream& is) {
+        FIGURE_TIME(read);
+        FIGURE_COUNT(records_read);
         std::vector<Point<T>> points(_vertices_number);
         for (size_t i{0}; i < static_cast<size_t>(_vertices_number); ++i) {
             is >> points[i];
@@ -160,16 +459,7 @@ protected:
 
 protected:
     virtual bool sides_invalid(const std::vector<Point<T>>& points) {
-        for (size_t i{0}; i < points.size(); ++i) {
-            Point<T> v1 = points[(i + 1) % points.size()] - points[i];
-            Point<T> v2 = points[(i + 2) % points.size()] - points[(i + 1) % points.size()];
-            T v_product_factor = vector_product_factor(v1, v2);
-            if (v_product_factor > 0 || std::abs(v_product_factor) < Point<T>::eps || 
-                    v1.length() < Point<T>::eps || v2.length() < Point<T>::eps) {
-                return true;
-            }
-        }
-        return false;
+        return convex_polygon_invalid(points.data(), points.size());
     }
 };
 
@@ -0,0 +1,181 @@
+#ifndef FIGURE_BINARY_H
+#define FIGURE_BINARY_H
+
+#include "./regular_polygon.h"
+#include "./inline_regular_polygon.h"
+#include "./my_array.h"
+#include "./mapped_file.h"
+#include "./instrumentation.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// Binary snapshot of regular polygons with the same number of vertices:
+// a 64-byte header followed by figures_number * V points stored as (x, y) pairs
+// in the writer's native byte order. The header keeps the data aligned, so a
+// mapped file can be read as an array of Point<T> in place.
+struct FigureFileHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t byte_order_mark;
+    uint8_t figure_type;
+    uint8_t scalar_size;
+    uint16_t reserved;
+    uint32_t vertices_number;
+    uint64_t figures_number;
+    uint8_t padding[40];
+};
+
+static_assert(sizeof(FigureFileHeader) == 64, "Figure file header must be 64 bytes");
+
+inline constexpr char figure_file_magic[4]{'F', 'I', 'G', 'B'};
+inline constexpr uint16_t figure_file_version{1};
+inline constexpr uint16_t figure_file_byte_order_mark{0x0102};
+inline constexpr uint8_t figure_file_regular_polygon{1};
+
+template <Scalar T>
+FigureFileHeader make_figure_file_header(uint32_t vertices_number, uint64_t figures_number) {
+    FigureFileHeader header{};
+    std::memcpy(header.magic, figure_file_magic, sizeof(header.magic));
+    header.version = figure_file_version;
+    header.byte_order_mark = figure_file_byte_order_mark;
+    header.figure_type = figure_file_regular_polygon;
+    header.scalar_size = sizeof(T);
+    header.vertices_number = vertices_number;
+    header.figures_number = figures_number;
+    return header;
+}
+
+// Writes an array of RegularPolygon<T, V> or InlineRegularPolygon<T, V>.
+template <typename F>
+requires requires { F::vertices_number; }
+std::ostream& write_binary(std::ostream& os, const MyArray<F>& figures) {
+    using T = typename F::value_type;
+    constexpr int V = F::vertices_number;
+    FIGURE_TIME(print);
+    FIGURE_COUNT_N(records_written, figures.size());
+    FigureFileHeader header = make_figure_file_header<T>(V, figures.size());
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::array<T, 2 * V> coords;
+    for (size_t i{0}; i < figures.size(); ++i) {
+        for (int j{0}; j < V; ++j) {
+            Point<T> p = figures[i][j];
+            coords[2 * j] = p.get_x();
+            coords[2 * j + 1] = p.get_y();
+        }
+        os.write(reinterpret_cast<const char*>(coords.data()), sizeof(coords));
+    }
+    return os;
+}
+
+template <typename F>
+requires requires { F::vertices_number; }
+void save_binary(const std::string& path, const MyArray<F>& figures) {
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    write_binary(os, figures);
+    if (!os) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+// Memory-mapped view of a binary figure file. Figures are exposed as spans of
+// points inside the mapping, nothing is copied or parsed when the file is opened.
+template <Scalar T, int V>
+class MappedFigures final
+{
+    static_assert(sizeof(Point<T>) == 2 * sizeof(T), "Point must consist of two packed coordinates");
+
+public:
+    using value_type = T;
+
+private:
+    MappedFile _file;
+    size_t _size{0};
+    const Point<T>* _points{nullptr};
+
+public:
+    explicit MappedFigures(const std::string& path) :
+        _file(path)
+    {
+        if (_file.size() < sizeof(FigureFileHeader)) {
+            throw std::runtime_error("File is too small for a figure file header");
+        }
+        FigureFileHeader header;
+        std::memcpy(&header, _file.data(), sizeof(header));
+        if (std::memcmp(header.magic, figure_file_magic, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("Not a figure file");
+        }
+        if (header.version != figure_file_version) {
+            throw std::runtime_error("Unsupported figure file version");
+        }
+        if (header.byte_order_mark != figure_file_byte_order_mark) {
+            throw std::runtime_error("Figure file has a different byte order");
+        }
+        if (header.figure_type != figure_file_regular_polygon || header.vertices_number != V) {
+            throw std::runtime_error("Figure file holds another kind of figures");
+        }
+        if (header.scalar_size != sizeof(T)) {
+            throw std::runtime_error("Figure file holds another coordinate precision");
+        }
+        const size_t available = (_file.size() - sizeof(FigureFileHeader)) / (V * sizeof(Point<T>));
+        if (header.figures_number > available) {
+            throw std::runtime_error("Figure file is truncated");
+        }
+        _size = header.figures_number;
+        _points = reinterpret_cast<const Point<T>*>(_file.data() + sizeof(FigureFileHeader));
+    }
+
+public:
+    size_t size() const {
+        return _size;
+    }
+
+    // All vertices of all figures, V per figure.
+    std::span<const Point<T>> points() const {
+        return std::span<const Point<T>>(_points, _size * V);
+    }
+
+    std::span<const Point<T>> operator[](size_t index) const {
+        if (index >= _size) {
+            throw std::out_of_range("Index is out of range");
+        }
+        return std::span<const Point<T>>(_points + index * V, V);
+    }
+
+    // Copies and validates one figure.
+    InlineRegularPolygon<T, V> figure(size_t index) const {
+        std::span<const Point<T>> vertices = (*this)[index];
+        return InlineRegularPolygon<T, V>(std::vector<Point<T>>(vertices.begin(), vertices.end()));
+    }
+
+    Point<T> calc_centre(size_t index) const {
+        Point<T> summ;
+        for (const auto &p : (*this)[index]) {
+            summ += p;
+        }
+        return summ / V;
+    }
+
+    T square(size_t index) const {
+        std::span<const Point<T>> vertices = (*this)[index];
+        return regular_polygon_square<T>(V, (vertices[1] - vertices[0]).length());
+    }
+
+    T total_square() const {
+        T total_square{0};
+        for (size_t i{0}; i < _size; ++i) {
+            total_square += square(i);
+        }
+        return total_square;
+    }
+};
+
+#endif
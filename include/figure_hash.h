@@ -0,0 +1,56 @@
+#ifndef FIGURE_HASH_H
+#define FIGURE_HASH_H
+
+#include "./point.h"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+// Hash key consistent with RegularPolygon::operator==, which treats figures as equal
+// when they have the same number of vertices and side lengths closer than Point<T>::eps.
+// The side is quantized into buckets of width eps, so equal figures fall into the same
+// or an adjacent bucket and lookups probe side_bucket - 1, side_bucket and side_bucket + 1.
+struct FigureHashKey {
+    int vertices_number;
+    int64_t side_bucket;
+
+    bool operator==(const FigureHashKey& other) const {
+        return vertices_number == other.vertices_number && side_bucket == other.side_bucket;
+    }
+
+    FigureHashKey neighbour(int64_t offset) const {
+        return FigureHashKey{vertices_number, side_bucket + offset};
+    }
+};
+
+struct FigureHashKeyHash {
+    size_t operator()(const FigureHashKey& key) const {
+        size_t h = std::hash<int64_t>{}(key.side_bucket);
+        return h ^ (std::hash<int>{}(key.vertices_number) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+    }
+};
+
+// Quotients beyond +-2^62 (sides above about 4.6e12 for double) and NaN share the end
+// buckets, so the cast to int64_t stays defined and neighbour() cannot overflow.
+template <Scalar T>
+FigureHashKey make_figure_hash_key(int vertices_number, T side) {
+    constexpr double limit = 0x1p62;
+    const double quotient = std::floor(static_cast<double>(side) / static_cast<double>(Point<T>::eps));
+    int64_t bucket;
+    if (!(quotient < limit)) {
+        bucket = static_cast<int64_t>(limit);
+    } else if (quotient <= -limit) {
+        bucket = -static_cast<int64_t>(limit);
+    } else {
+        bucket = static_cast<int64_t>(quotient);
+    }
+    return FigureHashKey{vertices_number, bucket};
+}
+
+// Works for every figure with operator[] and get_vertices_number().
+template <typename F>
+FigureHashKey figure_hash_key(const F& figure) {
+    return make_figure_hash_key(figure.get_vertices_number(), (figure[1] - figure[0]).length());
+}
+
+#endif
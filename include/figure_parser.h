@@ -0,0 +1,206 @@
+#ifndef FIGURE_PARSER_H
+#define FIGURE_PARSER_H
+
+#include "./regular_polygon.h"
+#include "./inline_regular_polygon.h"
+#include "./figure_store.h"
+#include "./my_array.h"
+#include "./instrumentation.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Bulk text ingest. The input holds one figure per line as 2 * V whitespace separated
+// coordinates, the format Figure::read accepts. Numbers are parsed with std::from_chars,
+// so parsing does not depend on the locale, does not go through iostreams and reuses
+// one scratch buffer for all records. Bad lines are reported, not thrown.
+
+struct ParseError {
+    size_t line;
+    const char* message;
+};
+
+struct ParseResult {
+    size_t parsed{0};
+    std::vector<ParseError> errors;
+};
+
+namespace figure_parser_detail {
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+inline const char* skip_spaces(const char* first, const char* last) {
+    while (first != last && is_space(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+} // namespace figure_parser_detail
+
+// Parses the coordinates of one record into points. Returns an error message or nullptr.
+template <Scalar T, int V>
+const char* parse_figure_record(std::string_view line, std::span<Point<T>, V> points) {
+    using namespace figure_parser_detail;
+    const char *first = line.data();
+    const char *last = line.data() + line.size();
+    for (int i{0}; i < V; ++i) {
+        T coords[2];
+        for (auto &coord : coords) {
+            first = skip_spaces(first, last);
+            if (first == last) {
+                return "Too few coordinates";
+            }
+            auto [ptr, ec] = std::from_chars(first, last, coord);
+            if (ec != std::errc() || (ptr != last && !is_space(*ptr))) {
+                return "Invalid number";
+            }
+            // from_chars also reads "nan" and "inf", which istream >> does not.
+            if (!std::isfinite(coord)) {
+                return "Invalid number";
+            }
+            first = ptr;
+        }
+        points[i] = Point<T>(coords[0], coords[1]);
+    }
+    if (skip_spaces(first, last) != last) {
+        return "Too many coordinates";
+    }
+    return nullptr;
+}
+
+namespace figure_parser_detail {
+
+// Splits the buffer into lines and hands every non-blank one to parse_record.
+template <Scalar T, int V, typename Sink, typename RecordParser>
+ParseResult parse_lines(std::string_view buffer, Sink& sink, size_t first_line, RecordParser parse_record) {
+    ParseResult result;
+    std::array<Point<T>, V> scratch;
+    size_t line_number{first_line};
+    while (!buffer.empty()) {
+        size_t end = buffer.find('\n');
+        std::string_view line = buffer.substr(0, end);
+        buffer.remove_prefix(end == std::string_view::npos ? buffer.size() : end + 1);
+        if (skip_spaces(line.data(), line.data() + line.size()) != line.data() + line.size()) {
+            if (const char *error = parse_record(line, std::span<Point<T>, V>(scratch))) {
+                result.errors.push_back(ParseError{line_number, error});
+            } else if (!sink(std::span<const Point<T>, V>(scratch))) {
+                FIGURE_COUNT(validation_rejects);
+                result.errors.push_back(ParseError{line_number, "Invalid sides"});
+            } else {
+                FIGURE_COUNT(records_read);
+                ++result.parsed;
+            }
+        }
+        ++line_number;
+    }
+    return result;
+}
+
+} // namespace figure_parser_detail
+
+// Parses one record in the operator<< format, "Hexagone: [ (x, y), (x, y), ... ]".
+// The "i: " prefix MyArray::print adds and the figure name are optional, a name that
+// does not match V is an error. Returns an error message or nullptr.
+template <Scalar T, int V>
+const char* parse_printed_figure_record(std::string_view line, std::span<Point<T>, V> points) {
+    using namespace figure_parser_detail;
+    const char *first = skip_spaces(line.data(), line.data() + line.size());
+    const char *last = line.data() + line.size();
+    size_t index;
+    if (auto [ptr, ec] = std::from_chars(first, last, index); ec == std::errc() && ptr != last && *ptr == ':') {
+        first = skip_spaces(ptr + 1, last);
+    }
+    const char *bracket = std::find(first, last, '[');
+    if (bracket == last) {
+        return "Missing '['";
+    }
+    std::string_view name(first, bracket - first);
+    while (!name.empty() && is_space(name.back())) {
+        name.remove_suffix(1);
+    }
+    if (!name.empty() && (name.back() != ':' || name.substr(0, name.size() - 1) != regular_polygon_name(V))) {
+        return "Unexpected figure name";
+    }
+    first = bracket + 1;
+    auto expect = [&](char c) {
+        first = skip_spaces(first, last);
+        if (first == last || *first != c) {
+            return false;
+        }
+        ++first;
+        return true;
+    };
+    auto number = [&](T& value) {
+        first = skip_spaces(first, last);
+        auto [ptr, ec] = std::from_chars(first, last, value);
+        first = ptr;
+        return ec == std::errc() && std::isfinite(value);
+    };
+    for (int i{0}; i < V; ++i) {
+        T x;
+        T y;
+        if ((i > 0 && !expect(',')) || !expect('(')) {
+            return "Too few points";
+        }
+        if (!number(x) || !expect(',') || !number(y) || !expect(')')) {
+            return "Invalid point";
+        }
+        points[i] = Point<T>(x, y);
+    }
+    if (!expect(']')) {
+        return "Too many points";
+    }
+    if (skip_spaces(first, last) != last) {
+        return "Unexpected text after ']'";
+    }
+    return nullptr;
+}
+
+// Calls sink(std::span<const Point<T>, V>) for every well-formed record. The sink returns
+// false if the points are not a valid figure. Empty lines are skipped. Line numbers start at 1.
+template <Scalar T, int V, typename Sink>
+requires std::predicate<Sink&, std::span<const Point<T>, V>>
+ParseResult parse_figures(std::string_view buffer, Sink sink, size_t first_line = 1) {
+    FIGURE_TIME(read);
+    return figure_parser_detail::parse_lines<T, V>(buffer, sink, first_line, parse_figure_record<T, V>);
+}
+
+template <Scalar T, int V>
+ParseResult parse_figures(std::string_view buffer, FigureStore<T, V>& store) {
+    return parse_figures<T, V>(buffer, [&store](std::span<const Point<T>, V> points) {
+        return store.try_push_back(points);
+    });
+}
+
+// Same as parse_figures for text written with operator<< or MyArray::print. Coordinates are
+// read back as printed, so dumps meant for loading should be written with enough precision
+// for the figures to pass validation again.
+template <Scalar T, int V, typename Sink>
+requires std::predicate<Sink&, std::span<const Point<T>, V>>
+ParseResult parse_printed_figures(std::string_view buffer, Sink sink, size_t first_line = 1) {
+    FIGURE_TIME(read);
+    return figure_parser_detail::parse_lines<T, V>(buffer, sink, first_line, parse_printed_figure_record<T, V>);
+}
+
+template <Scalar T, int V>
+ParseResult parse_figures(std::string_view buffer, MyArray<InlineRegularPolygon<T, V>>& figures) {
+    return parse_figures<T, V>(buffer, [&figures](std::span<const Point<T>, V> points) {
+        std::optional<InlineRegularPolygon<T, V>> figure = InlineRegularPolygon<T, V>::make(points);
+        if (!figure) {
+            return false;
+        }
+        figures.push_back(*figure);
+        return true;
+    });
+}
+
+#endif
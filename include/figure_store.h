@@ -0,0 +1,203 @@
+#ifndef FIGURE_STORE_H
+#define FIGURE_STORE_H
+
+#include "./regular_polygon.h"
+#include <iostream>
+#include <exception>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+// Structure-of-arrays storage for regular polygons with the same number of vertices.
+// Vertex j of figure i lives at _xs[i * V + j], _ys[i * V + j].
+template <Scalar T, int V>
+class FigureStore
+{
+    static_assert(V >= 3, "There are too few vertices");
+
+public:
+    using value_type = T;
+    using figure_type = RegularPolygon<T, V>;
+
+private:
+    size_t _size;
+    std::vector<T> _xs;
+    std::vector<T> _ys;
+
+public:
+    FigureStore(size_t n) :
+        _size(0)
+    {
+        reserve(n);
+        figure_type figure;
+        for (size_t i{0}; i < n; ++i) {
+            push_back(figure);
+        }
+    }
+
+    FigureStore(const std::initializer_list<figure_type>& figures) :
+        _size(0)
+    {
+        reserve(figures.size());
+        for (const auto &figure : figures) {
+            push_back(figure);
+        }
+    }
+
+    FigureStore(const FigureStore<T, V>& other) = default;
+
+    FigureStore(FigureStore<T, V>&& other) noexcept :
+        _size(other._size),
+        _xs(std::move(other._xs)),
+        _ys(std::move(other._ys))
+    {
+        other._size = 0;
+    }
+
+    FigureStore<T, V>& operator=(const FigureStore<T, V>& other) = default;
+
+    FigureStore<T, V>& operator=(FigureStore<T, V>&& other) noexcept {
+        if (this != &other) {
+            _size = other._size;
+            _xs = std::move(other._xs);
+            _ys = std::move(other._ys);
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    ~FigureStore() noexcept = default;
+
+public:
+    size_t size() const {
+        return _size;
+    }
+
+    void reserve(size_t n) {
+        _xs.reserve(n * V);
+        _ys.reserve(n * V);
+    }
+
+    void push_back(const figure_type& figure) {
+        _xs.resize(_xs.size() + V);
+        _ys.resize(_ys.size() + V);
+        ++_size;
+        store(_size - 1, figure);
+    }
+
+    // Non-throwing insertion of raw vertices. Returns false and keeps the store
+    // unchanged if the points do not form a valid polygon. regular_polygon_invalid is
+    // the rule RegularPolygon validates with, so operator[] can always rebuild the figure.
+    bool try_push_back(std::span<const Point<T>, V> points) {
+        if (regular_polygon_invalid<T, V>(points.data())) {
+            return false;
+        }
+        for (const auto &p : points) {
+            _xs.push_back(p.get_x());
+            _ys.push_back(p.get_y());
+        }
+        ++_size;
+        return true;
+    }
+
+    figure_type operator[](size_t index) const {
+        if (index >= _size) {
+            throw std::out_of_range("Index is out of range");
+        }
+        std::vector<Point<T>> points(V);
+        for (int j{0}; j < V; ++j) {
+            points[j] = vertex(index, j);
+        }
+        return figure_type(points);
+    }
+
+    Point<T> vertex(size_t index, int vertex_index) const {
+        return Point<T>(_xs[index * V + vertex_index], _ys[index * V + vertex_index]);
+    }
+
+    const T* xs() const {
+        return _xs.data();
+    }
+
+    const T* ys() const {
+        return _ys.data();
+    }
+
+public:
+    Point<T> calc_centre(size_t index) const {
+        const T *xs = _xs.data() + index * V;
+        const T *ys = _ys.data() + index * V;
+        T x{0};
+        T y{0};
+        for (int j{0}; j < V; ++j) {
+            x += xs[j];
+            y += ys[j];
+        }
+        return Point<T>(x / V, y / V);
+    }
+
+    T square(size_t index) const {
+        const T dx = _xs[index * V + 1] - _xs[index * V];
+        const T dy = _ys[index * V + 1] - _ys[index * V];
+        return regular_polygon_square<T>(V, std::sqrt(dx * dx + dy * dy));
+    }
+
+    std::istream& read(size_t index, std::istream& is) {
+        if (index >= _size) {
+            throw std::out_of_range("Index is out of range");
+        }
+        figure_type figure;
+        is >> figure;
+        store(index, figure);
+        return is;
+    }
+
+    std::ostream& print(std::ostream& os) const {
+        for (size_t i{0}; i < _size; ++i) {
+            os << i << ": " << (*this)[i] << std::endl;
+        }
+        return os;
+    }
+
+    std::ostream& print_centres(std::ostream& os) const {
+        for (size_t i{0}; i < _size; ++i) {
+            os << i << ": " << calc_centre(i) << std::endl;
+        }
+        return os;
+    }
+
+    std::ostream& print_squares(std::ostream& os) const {
+        for (size_t i{0}; i < _size; ++i) {
+            os << i << ": " << square(i) << std::endl;
+        }
+        return os;
+    }
+
+    T total_square() const {
+        T total_square{0};
+        for (size_t i{0}; i < _size; ++i) {
+            total_square += square(i);
+        }
+        return total_square;
+    }
+
+    void remove(size_t index) {
+        if (index >= _size) {
+            throw std::out_of_range("Index is out of range");
+        }
+        _xs.erase(_xs.begin() + index * V, _xs.begin() + (index + 1) * V);
+        _ys.erase(_ys.begin() + index * V, _ys.begin() + (index + 1) * V);
+        --_size;
+    }
+
+private:
+    void store(size_t index, const figure_type& figure) {
+        for (int j{0}; j < V; ++j) {
+            Point<T> p = figure[j];
+            _xs[index * V + j] = p.get_x();
+            _ys[index * V + j] = p.get_y();
+        }
+    }
+};
+
+#endif
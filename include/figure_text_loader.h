@@ -0,0 +1,94 @@
+#ifndef FIGURE_TEXT_LOADER_H
+#define FIGURE_TEXT_LOADER_H
+
+#include "./figure_parser.h"
+#include "./inline_regular_polygon.h"
+#include "./my_array.h"
+#include "./mapped_file.h"
+#include "./parallel.h"
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Parallel loading of text dumps in the operator<< / MyArray::print format. The buffer
+// is cut into chunks of about text_chunk_size bytes, each moved forward to the next
+// line start, the chunks are parsed on all threads and their figures appended in order.
+
+inline constexpr size_t text_chunk_size{1 << 20};
+
+namespace figure_text_loader_detail {
+
+// Chunk boundaries, every one but the first right after a '\n'.
+inline std::vector<size_t> split_at_lines(std::string_view buffer, size_t chunk_size) {
+    std::vector<size_t> bounds{0};
+    while (bounds.back() + chunk_size < buffer.size()) {
+        size_t end = buffer.find('\n', bounds.back() + chunk_size);
+        if (end == std::string_view::npos) {
+            break;
+        }
+        bounds.push_back(end + 1);
+    }
+    bounds.push_back(buffer.size());
+    return bounds;
+}
+
+} // namespace figure_text_loader_detail
+
+// Appends the figures of the buffer to figures in buffer order. Line numbers in the
+// errors are global, as if the buffer were parsed in one piece.
+template <Scalar T, int V>
+ParseResult parse_printed_figures(std::string_view buffer, MyArray<InlineRegularPolygon<T, V>>& figures,
+        size_t threads_number, size_t chunk_size = text_chunk_size) {
+    using figure_type = InlineRegularPolygon<T, V>;
+    const std::vector<size_t> bounds = figure_text_loader_detail::split_at_lines(buffer, std::max<size_t>(chunk_size, 1));
+    const size_t chunks_number = bounds.size() - 1;
+    std::vector<std::vector<figure_type>> chunk_figures(chunks_number);
+    std::vector<ParseResult> chunk_results(chunks_number);
+    std::vector<size_t> chunk_lines(chunks_number);
+    parallel_for_tasks(chunks_number, threads_number, [&](size_t chunk) {
+        std::string_view text = buffer.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+        chunk_lines[chunk] = std::count(text.begin(), text.end(), '\n');
+        std::vector<figure_type> &parsed = chunk_figures[chunk];
+        chunk_results[chunk] = parse_printed_figures<T, V>(text, [&parsed](std::span<const Point<T>, V> points) {
+            std::optional<figure_type> figure = figure_type::make(points);
+            if (!figure) {
+                return false;
+            }
+            parsed.push_back(*figure);
+            return true;
+        });
+    });
+
+    ParseResult result;
+    size_t total{figures.size()};
+    for (const auto &parsed : chunk_figures) {
+        total += parsed.size();
+    }
+    figures.reserve(total);
+    size_t first_line{0};
+    for (size_t chunk{0}; chunk < chunks_number; ++chunk) {
+        for (const auto &figure : chunk_figures[chunk]) {
+            figures.push_back(figure);
+        }
+        result.parsed += chunk_results[chunk].parsed;
+        for (const auto &error : chunk_results[chunk].errors) {
+            result.errors.push_back(ParseError{error.line + first_line, error.message});
+        }
+        first_line += chunk_lines[chunk];
+    }
+    return result;
+}
+
+// Memory-maps the file and loads it with parse_printed_figures.
+// threads_number == 0 uses all hardware threads.
+template <Scalar T, int V>
+ParseResult load_printed_figures(const std::string& path, MyArray<InlineRegularPolygon<T, V>>& figures,
+        size_t threads_number = 0) {
+    MappedFile file(path);
+    return parse_printed_figures<T, V>(file.view(), figures, threads_number);
+}
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef INGEST_PIPELINE_H
+#define INGEST_PIPELINE_H
+
+#include "./regular_polygon.h"
+#include "./inline_regular_polygon.h"
+#include "./figure_parser.h"
+#include "./my_array.h"
+#include "./spsc_queue.h"
+#include "./parallel.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Pipelined text ingest in the format parse_figures accepts. Three stages run at once:
+//
+//   parser thread -> validator threads -> committing (calling) thread
+//
+// The parser hands record k to validator k % N, each through its own bounded SPSC queue,
+// and the committer reads the validators' output queues in the same round-robin order.
+// So figures reach the sink in input order although validation runs in parallel.
+// A stage that finds its output queue full waits, which throttles the stages before it.
+
+struct StageStats {
+    size_t items{0};
+    uint64_t busy_nanoseconds{0};
+    // Times the stage had to wait for an empty input or a full output queue.
+    size_t stalls{0};
+
+    double items_per_second() const {
+        return busy_nanoseconds ? items * 1e9 / busy_nanoseconds : 0;
+    }
+};
+
+struct IngestStats {
+    StageStats parse;
+    // Summed over the validator threads.
+    StageStats validate;
+    StageStats commit;
+    size_t validators_number{0};
+    uint64_t elapsed_nanoseconds{0};
+};
+
+struct IngestResult {
+    size_t parsed{0};
+    std::vector<ParseError> errors;
+    IngestStats stats;
+};
+
+namespace ingest_pipeline_detail {
+
+template <Scalar T, int V>
+struct Record {
+    std::array<Point<T>, V> points;
+    size_t line{0};
+    const char* error{nullptr};
+    bool last{false};
+};
+
+class StageClock
+{
+private:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr size_t spin_retries{64};
+    static constexpr std::chrono::microseconds max_pause{500};
+
+    StageStats& _stats;
+    clock::time_point _start;
+    uint64_t _stalled{0};
+
+public:
+    explicit StageClock(StageStats& stats) :
+        _stats(stats), _start(clock::now())
+    {}
+
+    ~StageClock() {
+        auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start).count();
+        _stats.busy_nanoseconds += static_cast<uint64_t>(total) - _stalled;
+    }
+
+    // Retries attempt() until it succeeds or the pipeline is cancelled. Yields first, then
+    // sleeps with exponential backoff, so a stage stalled for long does not burn a core.
+    template <typename Attempt>
+    bool wait_for(Attempt attempt, const std::atomic<bool>& cancelled) {
+        if (attempt()) {
+            return true;
+        }
+        ++_stats.stalls;
+        clock::time_point start = clock::now();
+        bool done{false};
+        size_t retries{0};
+        std::chrono::microseconds pause{1};
+        while (!(done = attempt()) && !cancelled.load(std::memory_order_relaxed)) {
+            if (++retries <= spin_retries) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(pause);
+                pause = std::min(pause * 2, max_pause);
+            }
+        }
+        _stalled += std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+        return done;
+    }
+};
+
+} // namespace ingest_pipeline_detail
+
+// Calls sink(std::span<const Point<T>, V>) in input order for every record that parses
+// and passes regular_polygon_invalid, the check RegularPolygon validates with. Non-finite
+// coordinates are already rejected by the parse stage.
+// validators_number == 0 uses the hardware threads left after the parser and the
+// committer. If the sink throws, the pipeline is stopped and the exception rethrown.
+template <Scalar T, int V, typename Sink>
+requires std::invocable<Sink&, std::span<const Point<T>, V>>
+IngestResult ingest_figures(std::string_view buffer, Sink sink, size_t validators_number = 0,
+        size_t queue_capacity = 1024) {
+    using namespace ingest_pipeline_detail;
+    using Queue = SpscQueue<Record<T, V>>;
+    if (validators_number == 0) {
+        const size_t hardware = resolve_threads_number(0);
+        validators_number = hardware > 3 ? hardware - 2 : 1;
+    }
+    const auto started = std::chrono::steady_clock::now();
+    IngestResult result;
+    result.stats.validators_number = validators_number;
+    std::vector<std::unique_ptr<Queue>> to_validate;
+    std::vector<std::unique_ptr<Queue>> to_commit;
+    for (size_t i{0}; i < validators_number; ++i) {
+        to_validate.push_back(std::make_unique<Queue>(queue_capacity));
+        to_commit.push_back(std::make_unique<Queue>(queue_capacity));
+    }
+    std::vector<StageStats> validate_stats(validators_number);
+    std::atomic<bool> cancelled{false};
+    std::thread parser;
+    std::vector<std::thread> validators;
+    validators.reserve(validators_number);
+    auto join = [&] {
+        if (parser.joinable()) {
+            parser.join();
+        }
+        for (auto &validator : validators) {
+            validator.join();
+        }
+    };
+
+    auto parse = [&] {
+        StageClock clock(result.stats.parse);
+        Record<T, V> record;
+        size_t next{0};
+        auto send = [&] {
+            Queue &queue = *to_validate[next];
+            next = (next + 1) % validators_number;
+            return clock.wait_for([&] { return queue.try_push(record); }, cancelled);
+        };
+        size_t line_number{1};
+        std::string_view rest = buffer;
+        while (!rest.empty()) {
+            size_t end = rest.find('\n');
+            std::string_view line = rest.substr(0, end);
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+            if (figure_parser_detail::skip_spaces(line.data(), line.data() + line.size()) != line.data() + line.size()) {
+                record.line = line_number;
+                record.error = parse_figure_record<T, V>(line, record.points);
+                ++result.stats.parse.items;
+                if (!send()) {
+                    return;
+                }
+            }
+            ++line_number;
+        }
+        record.last = true;
+        for (size_t i{0}; i < validators_number; ++i) {
+            if (!send()) {
+                return;
+            }
+        }
+    };
+
+    auto validate = [&](size_t w) {
+        StageClock clock(validate_stats[w]);
+        Record<T, V> record;
+        while (clock.wait_for([&] { return to_validate[w]->try_pop(record); }, cancelled)) {
+            if (!record.last) {
+                if (!record.error && regular_polygon_invalid<T, V>(record.points.data())) {
+                    FIGURE_COUNT(validation_rejects);
+                    record.error = "Invalid sides";
+                }
+                ++validate_stats[w].items;
+            }
+            if (!clock.wait_for([&] { return to_commit[w]->try_push(record); }, cancelled) || record.last) {
+                return;
+            }
+        }
+    };
+
+    // A thread that fails to start stops the ones already running before the error leaves.
+    try {
+        parser = std::thread(parse);
+        for (size_t w{0}; w < validators_number; ++w) {
+            validators.emplace_back(validate, w);
+        }
+    } catch (...) {
+        cancelled.store(true);
+        join();
+        throw;
+    }
+
+    try {
+        StageClock clock(result.stats.commit);
+        Record<T, V> record;
+        for (size_t next{0}; ; next = (next + 1) % validators_number) {
+            clock.wait_for([&] { return to_commit[next]->try_pop(record); }, cancelled);
+            if (record.last) {
+                break;
+            }
+            if (record.error) {
+                result.errors.push_back(ParseError{record.line, record.error});
+            } else {
+                sink(std::span<const Point<T>, V>(record.points));
+                FIGURE_COUNT(records_read);
+                ++result.parsed;
+            }
+            ++result.stats.commit.items;
+        }
+    } catch (...) {
+        cancelled.store(true);
+        join();
+        throw;
+    }
+    // Validators behind the one that delivered the end marker stop once they forward theirs.
+    join();
+    for (const auto &stats : validate_stats) {
+        result.stats.validate.items += stats.items;
+        result.stats.validate.busy_nanoseconds += stats.busy_nanoseconds;
+        result.stats.validate.stalls += stats.stalls;
+    }
+    result.stats.elapsed_nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+template <Scalar T, int V>
+IngestResult ingest_figures(std::string_view buffer, MyArray<InlineRegularPolygon<T, V>>& figures,
+        size_t validators_number = 0, size_t queue_capacity = 1024) {
+    return ingest_figures<T, V>(buffer, [&figures](std::span<const Point<T>, V> points) {
+        figures.push_back(InlineRegularPolygon<T, V>::from_validated(points));
+    }, validators_number, queue_capacity);
+}
+
+#endif
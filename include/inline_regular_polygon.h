@@ -0,0 +1,191 @@
+#ifndef INLINE_REGULAR_POLYGON_H
+#define INLINE_REGULAR_POLYGON_H
+
+#include "./regular_polygon.h"
+#include "./bounding_box.h"
+#include "./instrumentation.h"
+#include <array>
+#include <optional>
+#include <span>
+#include <iostream>
+#include <initializer_list>
+#include <exception>
+#include <vector>
+
+// Regular polygon with its vertices stored inline. It has no heap buffer and no
+// virtual functions, so it is trivially copyable and MyArray of such polygons is
+// a single contiguous block.
+template <Scalar T, int V>
+class InlineRegularPolygon final
+{
+    static_assert(V >= 3, "There are too few vertices");
+
+    template<Scalar A, int B>
+    friend std::ostream& operator<<(std::ostream& os, const InlineRegularPolygon<A, B>& obj);
+
+    template<Scalar A, int B>
+    friend std::istream& operator>>(std::istream& is, InlineRegularPolygon<A, B>& obj);
+
+public:
+    using value_type = T;
+    static constexpr int vertices_number = V;
+
+private:
+    std::array<Point<T>, V> _points;
+
+public:
+    InlineRegularPolygon() {
+        for (int i{0}; i < V; ++i) {
+            _points[i] = Point<T>(regular_polygon_unit_points<T, V>[i][0], regular_polygon_unit_points<T, V>[i][1]);
+        }
+    }
+
+    InlineRegularPolygon(const std::vector<Point<T>>& points) {
+        set_points(points.data(), points.size());
+    }
+
+    InlineRegularPolygon(const std::initializer_list<Point<T>>& points) {
+        set_points(points.begin(), points.size());
+    }
+
+    InlineRegularPolygon(std::span<const Point<T>, V> points) {
+        set_points(points.data(), points.size());
+    }
+
+    explicit InlineRegularPolygon(const RegularPolygon<T, V>& other) {
+        for (int i{0}; i < V; ++i) {
+            _points[i] = other[i];
+        }
+    }
+
+    InlineRegularPolygon(const InlineRegularPolygon<T, V>& other) = default;
+
+    InlineRegularPolygon(InlineRegularPolygon<T, V>&& other) noexcept = default;
+
+    InlineRegularPolygon<T, V>& operator=(const InlineRegularPolygon<T, V>& other) = default;
+
+    InlineRegularPolygon<T, V>& operator=(InlineRegularPolygon<T, V>&& other) noexcept = default;
+
+    ~InlineRegularPolygon() noexcept = default;
+
+public:
+    // Non-throwing factory: returns nothing if the points do not form a valid polygon.
+    static std::optional<InlineRegularPolygon<T, V>> make(std::span<const Point<T>, V> points) {
+        if (regular_polygon_invalid<T, V>(points.data())) {
+            return std::nullopt;
+        }
+        InlineRegularPolygon<T, V> figure;
+        for (int i{0}; i < V; ++i) {
+            figure._points[i] = points[i];
+        }
+        return figure;
+    }
+
+    // Skips validation, for points already checked with regular_polygon_invalid
+    // (see ingest_figures).
+    static InlineRegularPolygon<T, V> from_validated(std::span<const Point<T>, V> points) {
+        InlineRegularPolygon<T, V> figure;
+        for (int i{0}; i < V; ++i) {
+            figure._points[i] = points[i];
+        }
+        return figure;
+    }
+
+public:
+    int get_vertices_number() const {
+        return V;
+    }
+
+    Point<T> operator[](int point_index) const {
+        if (point_index < 0 || point_index >= V) {
+            throw std::out_of_range("Point index is out of range");
+        }
+        return _points[point_index];
+    }
+
+    // Computed on every call to keep the polygon as small as its vertices.
+    BoundingBox<T> get_bounding_box() const {
+        return BoundingBox<T>::from_points(_points.data(), V);
+    }
+
+    Point<T> calc_centre() const {
+        Point<T> summ;
+        for (const auto &p : _points) {
+            summ += p;
+        }
+        return summ / V;
+    }
+
+    explicit operator T() const {
+        return square();
+    }
+
+    bool contains(const Point<T>& point) const {
+        return convex_polygon_contains(_points.data(), V, point);
+    }
+
+    void contains(std::span<const Point<T>> points, std::span<bool> result) const {
+        convex_polygon_contains(_points.data(), V, points, result);
+    }
+
+    bool operator==(const InlineRegularPolygon<T, V>& other) const {
+        return (_points[1] - _points[0]).abs_eq(other._points[1] - other._points[0]);
+    }
+
+    bool operator!=(const InlineRegularPolygon<T, V>& other) const {
+        return !(*this == other);
+    }
+
+public:
+    T square() const {
+        return regular_polygon_square<T>(V, (_points[1] - _points[0]).length());
+    }
+
+private:
+    void print(std::ostream& os) const {
+        FIGURE_COUNT(records_written);
+        print_regular_polygon_name(os, V);
+        os << "[ ";
+        for (int i{0}; i < V - 1; ++i) {
+            os << _points[i] << ", ";
+        }
+        os << _points[V - 1] << " ]";
+    }
+
+    void read(std::istream& is) {
+        FIGURE_TIME(read);
+        FIGURE_COUNT(records_read);
+        std::array<Point<T>, V> points;
+        for (auto &p : points) {
+            is >> p;
+        }
+        set_points(points.data(), points.size());
+    }
+
+    void set_points(const Point<T>* points, size_t count) {
+        if (count != V) {
+            throw std::invalid_argument("Invalid vertices number");
+        }
+        if (regular_polygon_invalid<T, V>(points)) {
+            FIGURE_COUNT(validation_rejects);
+            throw std::invalid_argument("Invalid sides");
+        }
+        for (int i{0}; i < V; ++i) {
+            _points[i] = points[i];
+        }
+    }
+};
+
+template<Scalar T, int V>
+std::ostream& operator<<(std::ostream& os, const InlineRegularPolygon<T, V>& obj) {
+    obj.print(os);
+    return os;
+}
+
+template<Scalar T, int V>
+std::istream& operator>>(std::istream& is, InlineRegularPolygon<T, V>& obj) {
+    obj.read(is);
+    return is;
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+// Hot-path counters and timers. Compiled in only when FIGURE_INSTRUMENTATION is defined
+// (cmake -DFIGURE_INSTRUMENTATION=ON), otherwise the hooks expand to nothing and
+// snapshot() returns zeros. Every thread writes its own slots without locking;
+// snapshot() sums the slots of live threads and of threads that have exited.
+
+namespace instrumentation {
+
+enum class Counter : size_t {
+    figure_copies,
+    figure_moves,
+    point_allocations,
+    validation_rejects,
+    remove_shifts,
+    array_reallocations,
+    array_detaches,
+    records_read,
+    records_written,
+    count
+};
+
+enum class Timer : size_t {
+    construction,
+    validation,
+    read,
+    print,
+    aggregation,
+    count
+};
+
+inline constexpr std::array<const char*, static_cast<size_t>(Counter::count)> counter_names{
+    "figure_copies", "figure_moves", "point_allocations", "validation_rejects",
+    "remove_shifts", "array_reallocations", "array_detaches", "records_read", "records_written"
+};
+
+inline constexpr std::array<const char*, static_cast<size_t>(Timer::count)> timer_names{
+    "construction", "validation", "read", "print", "aggregation"
+};
+
+struct TimerValue {
+    uint64_t calls{0};
+    uint64_t nanoseconds{0};
+};
+
+struct Snapshot {
+    std::array<uint64_t, static_cast<size_t>(Counter::count)> counters{};
+    std::array<TimerValue, static_cast<size_t>(Timer::count)> timers{};
+
+    uint64_t operator[](Counter counter) const {
+        return counters[static_cast<size_t>(counter)];
+    }
+
+    const TimerValue& operator[](Timer timer) const {
+        return timers[static_cast<size_t>(timer)];
+    }
+};
+
+#ifdef FIGURE_INSTRUMENTATION
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+} // namespace instrumentation
+
+#ifdef FIGURE_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace instrumentation {
+
+namespace detail {
+
+// Slots of one thread. Only the owner writes them, so relaxed load + store is enough
+// and other threads can read them while snapshotting.
+struct ThreadSlots {
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::count)> counters{};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Timer::count)> timer_calls{};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Timer::count)> timer_nanoseconds{};
+};
+
+inline void bump(std::atomic<uint64_t>& slot, uint64_t n) {
+    slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void add_to(Snapshot& snapshot, const ThreadSlots& slots) {
+    for (size_t i{0}; i < snapshot.counters.size(); ++i) {
+        snapshot.counters[i] += slots.counters[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i{0}; i < snapshot.timers.size(); ++i) {
+        snapshot.timers[i].calls += slots.timer_calls[i].load(std::memory_order_relaxed);
+        snapshot.timers[i].nanoseconds += slots.timer_nanoseconds[i].load(std::memory_order_relaxed);
+    }
+}
+
+class Registry
+{
+private:
+    std::mutex _mutex;
+    std::vector<ThreadSlots*> _threads;
+    Snapshot _retired;
+
+public:
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    void attach(ThreadSlots* slots) {
+        std::lock_guard lock(_mutex);
+        _threads.push_back(slots);
+    }
+
+    // Folds the totals of an exiting thread into the retired ones.
+    void detach(ThreadSlots* slots) {
+        std::lock_guard lock(_mutex);
+        add_to(_retired, *slots);
+        _threads.erase(std::find(_threads.begin(), _threads.end(), slots));
+    }
+
+    Snapshot snapshot() {
+        std::lock_guard lock(_mutex);
+        Snapshot result = _retired;
+        for (const ThreadSlots *slots : _threads) {
+            add_to(result, *slots);
+        }
+        return result;
+    }
+
+    // Owners bump their slots with a plain load + store, so a bump that overlaps this
+    // store of 0 can write the old count back. Only call it while no other thread is
+    // running instrumented code.
+    void reset() {
+        std::lock_guard lock(_mutex);
+        _retired = Snapshot();
+        for (ThreadSlots *slots : _threads) {
+            for (auto &counter : slots->counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            for (size_t i{0}; i < slots->timer_calls.size(); ++i) {
+                slots->timer_calls[i].store(0, std::memory_order_relaxed);
+                slots->timer_nanoseconds[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+class ThreadHandle
+{
+public:
+    ThreadSlots slots;
+
+public:
+    ThreadHandle() {
+        Registry::instance().attach(&slots);
+    }
+
+    ~ThreadHandle() {
+        Registry::instance().detach(&slots);
+    }
+};
+
+inline ThreadSlots& local_slots() {
+    thread_local ThreadHandle handle;
+    return handle.slots;
+}
+
+} // namespace detail
+
+inline void count(Counter counter, uint64_t n = 1) {
+    detail::bump(detail::local_slots().counters[static_cast<size_t>(counter)], n);
+}
+
+inline void record(Timer timer, uint64_t nanoseconds) {
+    detail::ThreadSlots &slots = detail::local_slots();
+    detail::bump(slots.timer_calls[static_cast<size_t>(timer)], 1);
+    detail::bump(slots.timer_nanoseconds[static_cast<size_t>(timer)], nanoseconds);
+}
+
+// Adds the time between construction and destruction to timer.
+class ScopedTimer
+{
+private:
+    Timer _timer;
+    std::chrono::steady_clock::time_point _start;
+
+public:
+    explicit ScopedTimer(Timer timer) :
+        _timer(timer), _start(std::chrono::steady_clock::now())
+    {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - _start;
+        record(_timer, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+};
+
+inline Snapshot snapshot() {
+    return detail::Registry::instance().snapshot();
+}
+
+// Zeroes every counter and timer. Instrumented threads must be quiescent, see Registry::reset.
+inline void reset() {
+    detail::Registry::instance().reset();
+}
+
+} // namespace instrumentation
+
+#define FIGURE_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define FIGURE_INSTRUMENTATION_CONCAT(a, b) FIGURE_INSTRUMENTATION_CONCAT_(a, b)
+#define FIGURE_COUNT(counter) ::instrumentation::count(::instrumentation::Counter::counter)
+#define FIGURE_COUNT_N(counter, n) ::instrumentation::count(::instrumentation::Counter::counter, (n))
+#define FIGURE_TIME(timer) \
+    ::instrumentation::ScopedTimer FIGURE_INSTRUMENTATION_CONCAT(figure_timer_, __LINE__)(::instrumentation::Timer::timer)
+
+#else
+
+namespace instrumentation {
+
+inline Snapshot snapshot() {
+    return Snapshot();
+}
+
+inline void reset() {}
+
+} // namespace instrumentation
+
+#define FIGURE_COUNT(counter) ((void)0)
+#define FIGURE_COUNT_N(counter, n) ((void)0)
+#define FIGURE_TIME(timer) ((void)0)
+
+#endif
+
+namespace instrumentation {
+
+// One "name value" line per counter and "name calls total_ns" per timer.
+inline std::ostream& dump(std::ostream& os, const Snapshot& snapshot = instrumentation::snapshot()) {
+    for (size_t i{0}; i < snapshot.counters.size(); ++i) {
+        os << counter_names[i] << " " << snapshot.counters[i] << std::endl;
+    }
+    for (size_t i{0}; i < snapshot.timers.size(); ++i) {
+        os << timer_names[i] << " " << snapshot.timers[i].calls << " " << snapshot.timers[i].nanoseconds << "ns" << std::endl;
+    }
+    return os;
+}
+
+} // namespace instrumentation
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only memory mapping of a whole file (POSIX).
+class MappedFile final
+{
+private:
+    const char* _data{nullptr};
+    size_t _size{0};
+
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+        }
+        _size = static_cast<size_t>(st.st_size);
+        if (_size > 0) {
+            void *data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+            }
+            _data = static_cast<const char*>(data);
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept :
+        _data(other._data),
+        _size(other._size)
+    {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            _data = other._data;
+            _size = other._size;
+            other._data = nullptr;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    ~MappedFile() noexcept {
+        unmap();
+    }
+
+public:
+    const char* data() const {
+        return _data;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    std::string_view view() const {
+        return std::string_view(_data, _size);
+    }
+
+private:
+    void unmap() noexcept {
+        if (_data) {
+            ::munmap(const_cast<char*>(_data), _size);
+            _data = nullptr;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef METRIC_CACHE_H
+#define METRIC_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+
+// Lazily filled value behind a const metric getter. Copy-on-write MyArray copies share
+// their figures, so several threads may fill the same cache at once: the first one
+// publishes its value, the others return the value they computed. reset() and
+// assignment belong to the owner and must not run while others read.
+template <typename V>
+class MetricCache final
+{
+private:
+    enum State : uint8_t { empty, filling, ready };
+
+    std::atomic<uint8_t> _state{empty};
+    V _value{};
+
+public:
+    MetricCache() = default;
+
+    MetricCache(const MetricCache<V>& other) {
+        *this = other;
+    }
+
+    MetricCache<V>& operator=(const MetricCache<V>& other) {
+        if (this != &other) {
+            if (other._state.load(std::memory_order_acquire) == ready) {
+                _value = other._value;
+                _state.store(ready, std::memory_order_relaxed);
+            } else {
+                _state.store(empty, std::memory_order_relaxed);
+            }
+        }
+        return *this;
+    }
+
+    ~MetricCache() noexcept = default;
+
+public:
+    template <typename Compute>
+    V get(Compute compute) {
+        if (_state.load(std::memory_order_acquire) == ready) {
+            return _value;
+        }
+        V value = compute();
+        uint8_t expected{empty};
+        if (_state.compare_exchange_strong(expected, filling, std::memory_order_relaxed)) {
+            _value = value;
+            _state.store(ready, std::memory_order_release);
+        }
+        return value;
+    }
+
+    void reset() {
+        _state.store(empty, std::memory_order_relaxed);
+    }
+};
+
+#endif
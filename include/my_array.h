@@ -4,76 +4,112 @@
 #include <iostream>
 #include <exception>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <utility>
 #include "./point.h"
+#include "./my_array_fwd.h"
+#include "./bounding_box.h"
+#include "./figure_hash.h"
+#include "./parallel.h"
+#include "./instrumentation.h"
 #include <type_traits>
 #include <concepts>
-
-template<typename T>
-concept IsFigure = requires (T t, std::ostream& os, std::istream& is) {
-    { is >> t } -> std::same_as<std::istream&>;
-    { os << t } -> std::same_as<std::ostream&>;
-    { t.calc_centre() } -> std::same_as<Point<typename T::value_type>>;
-    { static_cast<typename T::value_type>(t) } -> std::convertible_to<typename T::value_type>;
-};
+#include <unordered_map>
 
 template<typename T>
 requires IsFigure<T> || (std::is_pointer_v<T> && IsFigure<std::remove_pointer_t<T>>)
 class MyArray
 {
     using element_type = std::remove_pointer_t<T>;
+    using scalar_type = typename element_type::value_type;
+
+public:
+    // Figures stored by value receive the allocator through uses-allocator
+    // construction, so their vertex buffers come from the same resource.
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
 
 private:
-    size_t _size;
-    std::shared_ptr<T[]> _body;
+    // Elements [0, size) are constructed, the rest of the capacity is raw memory.
+    struct Storage {
+        std::pmr::memory_resource* resource;
+        size_t size{0};
+        size_t capacity{0};
+        T* data{nullptr};
 
-public:
-    MyArray(size_t n) :
-        _size(n),
-        _body(std::make_shared<T[]>(n))
-    {}
+        Storage(std::pmr::memory_resource* resource, size_t capacity) :
+            resource(resource),
+            capacity(capacity),
+            data(capacity ? static_cast<T*>(resource->allocate(capacity * sizeof(T), alignof(T))) : nullptr)
+        {}
+
+        Storage(const Storage&) = delete;
+        Storage& operator=(const Storage&) = delete;
+
+        ~Storage() noexcept {
+            std::destroy_n(data, size);
+            if (data) {
+                resource->deallocate(data, capacity * sizeof(T), alignof(T));
+            }
+        }
+    };
+
+private:
+    std::pmr::memory_resource* _resource;
+    std::shared_ptr<Storage> _body;
 
-    MyArray(const std::initializer_list<T>& figures) :
-        _size(figures.size()),
-        _body(std::make_shared<T[]>(figures.size()))
+public:
+    MyArray(size_t n, const allocator_type& allocator = {}) :
+        _resource(allocator.resource()),
+        _body(make_storage(n))
     {
-        size_t i{0};
-        for (const auto &figure : figures) {
-            _body[i] = figure;
-            ++i;
+        for (size_t i{0}; i < n; ++i) {
+            emplace_back();
         }
     }
 
-    MyArray(const MyArray<T>& other) :
-        _size(other._size),
-        _body(std::make_shared<T[]>(other._size))
+    MyArray(const std::initializer_list<T>& figures, const allocator_type& allocator = {}) :
+        _resource(allocator.resource()),
+        _body(make_storage(figures.size()))
     {
-        for (size_t i{0}; i < _size; ++i) {
-            _body[i] = other._body[i];
+        for (const auto &figure : figures) {
+            emplace_back(figure);
         }
     }
 
+    // Copies share the body while they use the same memory resource. The first mutation
+    // through either array detaches it, see detach().
+    MyArray(const MyArray<T>& other, const allocator_type& allocator = {}) :
+        _resource(allocator.resource()),
+        _body(other.get_allocator() == allocator ? other._body : other.copy_storage(_resource, other.size()))
+    {}
+
     MyArray(MyArray<T>&& other) noexcept {
-        _size = other._size;
+        _resource = other._resource;
         _body = std::move(other._body);
-        other._size = 0;
         other._body = nullptr;
     }
 
     MyArray<T>& operator=(const MyArray<T>& other) {
         if (this != &other) {
-            MyArray<T> other_copy(other);
-            std::swap(_size, other_copy._size);
-            std::swap(_body, other_copy._body);
+            _body = get_allocator() == other.get_allocator() ? other._body : other.copy_storage(_resource, other.size());
         }
         return *this;
     }
 
-    MyArray<T>& operator=(MyArray<T>&& other) noexcept {
+    // The resource does not propagate: the body is stolen only if both arrays use the
+    // same resource, otherwise the elements are copied into this array's one.
+    MyArray<T>& operator=(MyArray<T>&& other) {
         if (this != &other) {
-            _size = other._size;
-            _body = std::move(other._body);
-            other._size = 0;
-            other._body = nullptr;
+            if (get_allocator() == other.get_allocator()) {
+                _body = std::move(other._body);
+                other._body = nullptr;
+            } else {
+                _body = other.copy_storage(_resource, other.size());
+            }
         }
         return *this;
     }
@@ -82,74 +118,596 @@ public:
 
 public:
     size_t size() const {
-        return _size;
+        return _body ? _body->size : 0;
+    }
+
+    size_t capacity() const {
+        return _body ? _body->capacity : 0;
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(_resource);
+    }
+
+    // Detaches a shared body. The reference must not outlive a later copy of the array,
+    // writes through it would be seen by that copy.
+    T& operator[](size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        detach();
+        return _body->data[index];
+    }
+
+    const T& operator[](size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        return _body->data[index];
+    }
+
+public:
+    void reserve(size_t n) {
+        if (n > capacity()) {
+            reallocate(n);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (size() < capacity()) {
+            reallocate(size());
+        }
+    }
+
+    void push_back(const T& figure) {
+        emplace_back(figure);
+    }
+
+    void push_back(T&& figure) {
+        emplace_back(std::move(figure));
+    }
+
+    // Grows the capacity geometrically, so a series of insertions is amortized O(1).
+    // When the array is full, the new element is constructed in the new storage before the
+    // old elements are relocated, so args may refer into the array, as in push_back(a[0]).
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        allocator_type allocator(_resource);
+        T *place;
+        if (size() == capacity()) {
+            FIGURE_COUNT(array_reallocations);
+            std::shared_ptr<Storage> storage = make_storage(std::max<size_t>(2 * capacity(), 4));
+            place = storage->data + size();
+            std::allocator_traits<allocator_type>::construct(allocator, place, std::forward<Args>(args)...);
+            try {
+                relocate_into(*storage);
+            } catch (...) {
+                std::destroy_at(place);
+                throw;
+            }
+            _body = std::move(storage);
+        } else {
+            detach();
+            place = _body->data + _body->size;
+            std::allocator_traits<allocator_type>::construct(allocator, place, std::forward<Args>(args)...);
+        }
+        ++_body->size;
+        return *place;
     }
 
     std::istream& read(size_t index, std::istream& is) {
-        if (index >= _size) {
+        if (index >= size()) {
             throw std::out_of_range("Index is out of range");
         }
+        detach();
         if constexpr (std::is_pointer_v<T>) {
-            is >> *_body[index];
+            is >> *_body->data[index];
         } else {
-            is >> _body[index];
+            is >> _body->data[index];
         }
         return is;
     }
     
     std::ostream& print(std::ostream& os) {
-        for (size_t i{0}; i < _size; ++i) {
+        FIGURE_TIME(print);
+        for (size_t i{0}; i < size(); ++i) {
             os << i << ": ";
             if constexpr (std::is_pointer_v<T>) {
-                os << *_body[i] << std::endl;
+                os << *_body->data[i] << std::endl;
             } else {
-                os << _body[i] << std::endl;
+                os << _body->data[i] << std::endl;
             }
         }
         return os;
     }
 
+    std::ostream& print_centres(std::ostream& os, size_t threads_number) const {
+        std::vector<Point<scalar_type>> centres = calc_centres(threads_number);
+        for (size_t i{0}; i < size(); ++i) {
+            os << i << ": " << centres[i] << std::endl;
+        }
+        return os;
+    }
+
+    std::ostream& print_squares(std::ostream& os, size_t threads_number) const {
+        std::vector<scalar_type> squares = calc_squares(threads_number);
+        for (size_t i{0}; i < size(); ++i) {
+            os << i << ": " << squares[i] << std::endl;
+        }
+        return os;
+    }
+
+    std::vector<Point<scalar_type>> calc_centres(size_t threads_number = 1) const {
+        FIGURE_TIME(aggregation);
+        std::vector<Point<scalar_type>> centres(size());
+        parallel_for_chunks(size(), threads_number, [&](size_t, size_t begin, size_t end) {
+            for (size_t i{begin}; i < end; ++i) {
+                centres[i] = element(i).calc_centre();
+            }
+        });
+        return centres;
+    }
+
+    std::vector<scalar_type> calc_squares(size_t threads_number = 1) const {
+        FIGURE_TIME(aggregation);
+        std::vector<scalar_type> squares(size());
+        parallel_for_chunks(size(), threads_number, [&](size_t, size_t begin, size_t end) {
+            for (size_t i{begin}; i < end; ++i) {
+                squares[i] = static_cast<scalar_type>(element(i));
+            }
+        });
+        return squares;
+    }
+
     std::ostream& print_centres(std::ostream& os) const {
-        for (size_t i{0}; i < _size; ++i) {
+        for (size_t i{0}; i < size(); ++i) {
             os << i << ": ";
             if constexpr (std::is_pointer_v<T>) {
-                os << _body[i]->calc_centre() << std::endl;
+                os << _body->data[i]->calc_centre() << std::endl;
             } else {
-                os << _body[i].calc_centre() << std::endl;
+                os << _body->data[i].calc_centre() << std::endl;
             }
         }
         return os;
     }
 
     std::ostream& print_squares(std::ostream& os) const {
-        for (size_t i{0}; i < _size; ++i) {
+        for (size_t i{0}; i < size(); ++i) {
             os << i << ": ";
             if constexpr (std::is_pointer_v<T>) {
-                os << static_cast<typename element_type::value_type>(*_body[i]) << std::endl;
+                os << static_cast<typename element_type::value_type>(*_body->data[i]) << std::endl;
             } else {
-                os << static_cast<typename element_type::value_type>(_body[i]) << std::endl;
+                os << static_cast<typename element_type::value_type>(_body->data[i]) << std::endl;
             }
         }
         return os;
     }
 
-    typename element_type::value_type total_square() const {
-        typename element_type::value_type total_square{0};
-        for (size_t i{0}; i < _size; ++i) {
+    scalar_type total_square() const {
+        return total_square(1);
+    }
+
+    // Chunk sums are added in chunk order, so the result does not depend on threads_number.
+    // threads_number == 0 uses all hardware threads.
+    scalar_type total_square(size_t threads_number) const {
+        FIGURE_TIME(aggregation);
+        std::vector<scalar_type> chunk_squares(parallel_chunks_number(size()));
+        parallel_for_chunks(size(), threads_number, [&](size_t chunk, size_t begin, size_t end) {
+            scalar_type chunk_square{0};
+            for (size_t i{begin}; i < end; ++i) {
+                chunk_square += static_cast<scalar_type>(element(i));
+            }
+            chunk_squares[chunk] = chunk_square;
+        });
+        scalar_type total_square{0};
+        for (const auto &chunk_square : chunk_squares) {
+            total_square += chunk_square;
+        }
+        return total_square;
+    }
+
+    // Indices of figures whose bounding boxes intersect box.
+    std::vector<size_t> filter_by_box(const BoundingBox<scalar_type>& box) const
+    requires requires (const element_type& figure) { figure.get_bounding_box(); }
+    {
+        return filter_by_box(box, [](const element_type&) { return true; });
+    }
+
+    // Bounding box culling followed by the exact test for the figures that pass it.
+    template <typename Predicate>
+    std::vector<size_t> filter_by_box(const BoundingBox<scalar_type>& box, Predicate exact) const
+    requires requires (const element_type& figure) { figure.get_bounding_box(); }
+    {
+        std::vector<size_t> indices;
+        for (size_t i{0}; i < size(); ++i) {
+            if (element(i).get_bounding_box().intersects(box) && exact(element(i))) {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+
+    // Indices of figures whose bounding boxes contain the point, candidates for hit-testing.
+    std::vector<size_t> filter_by_point(const Point<scalar_type>& point) const
+    requires requires (const element_type& figure) { figure.get_bounding_box(); }
+    {
+        std::vector<size_t> indices;
+        for (size_t i{0}; i < size(); ++i) {
+            if (element(i).get_bounding_box().contains(point)) {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+
+public:
+    // Indices of the k largest figures by area, largest first. Equal areas are ordered by
+    // index. Every chunk keeps a bounded heap of its best k, so the cost is O(n log k)
+    // and only (area, index) pairs are copied.
+    std::vector<size_t> top_k_by_area(size_t k, size_t threads_number = 1) const {
+        k = std::min(k, size());
+        if (k == 0) {
+            return {};
+        }
+        using Entry = std::pair<scalar_type, size_t>;
+        // Heap top is the worst kept entry.
+        auto better = [](const Entry& a, const Entry& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        };
+        std::vector<std::vector<Entry>> chunk_best(parallel_chunks_number(size()));
+        parallel_for_chunks(size(), threads_number, [&](size_t chunk, size_t begin, size_t end) {
+            std::vector<Entry> &heap = chunk_best[chunk];
+            heap.reserve(std::min(k, end - begin));
+            for (size_t i{begin}; i < end; ++i) {
+                Entry entry(static_cast<scalar_type>(element(i)), i);
+                if (heap.size() < k) {
+                    heap.push_back(entry);
+                    std::push_heap(heap.begin(), heap.end(), better);
+                } else if (better(entry, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), better);
+                    heap.back() = entry;
+                    std::push_heap(heap.begin(), heap.end(), better);
+                }
+            }
+        });
+        std::vector<Entry> candidates;
+        for (const auto &heap : chunk_best) {
+            candidates.insert(candidates.end(), heap.begin(), heap.end());
+        }
+        std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), better);
+        candidates.resize(k);
+        std::sort(candidates.begin(), candidates.end(), better);
+        std::vector<size_t> indices(k);
+        for (size_t i{0}; i < k; ++i) {
+            indices[i] = candidates[i].second;
+        }
+        return indices;
+    }
+
+    // Index of the figure at position n when sorted by ascending area, equal areas by index.
+    // n == size() / 2 gives the median. Expected O(n) through nth_element.
+    size_t nth_by_area(size_t n, size_t threads_number = 1) const {
+        if (n >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        std::vector<scalar_type> squares = calc_squares(threads_number);
+        std::vector<size_t> indices(size());
+        for (size_t i{0}; i < size(); ++i) {
+            indices[i] = i;
+        }
+        std::nth_element(indices.begin(), indices.begin() + n, indices.end(), [&squares](size_t a, size_t b) {
+            return squares[a] < squares[b] || (squares[a] == squares[b] && a < b);
+        });
+        return indices[n];
+    }
+
+    // Indices of figures with min_square <= area <= max_square, ascending.
+    std::vector<size_t> filter_by_area(scalar_type min_square, scalar_type max_square, size_t threads_number = 1) const {
+        std::vector<std::vector<size_t>> chunk_indices(parallel_chunks_number(size()));
+        parallel_for_chunks(size(), threads_number, [&](size_t chunk, size_t begin, size_t end) {
+            for (size_t i{begin}; i < end; ++i) {
+                const scalar_type square = static_cast<scalar_type>(element(i));
+                if (square >= min_square && square <= max_square) {
+                    chunk_indices[chunk].push_back(i);
+                }
+            }
+        });
+        std::vector<size_t> indices;
+        for (const auto &chunk : chunk_indices) {
+            indices.insert(indices.end(), chunk.begin(), chunk.end());
+        }
+        return indices;
+    }
+
+    // Indices of figures containing the point. contains() culls by bounding box itself.
+    std::vector<size_t> filter_containing(const Point<scalar_type>& point, size_t threads_number = 1) const
+    requires requires (const element_type& figure) { figure.contains(point); }
+    {
+        std::vector<std::vector<size_t>> chunk_indices(parallel_chunks_number(size()));
+        parallel_for_chunks(size(), threads_number, [&](size_t chunk, size_t begin, size_t end) {
+            for (size_t i{begin}; i < end; ++i) {
+                if (element(i).contains(point)) {
+                    chunk_indices[chunk].push_back(i);
+                }
+            }
+        });
+        std::vector<size_t> indices;
+        for (const auto &chunk : chunk_indices) {
+            indices.insert(indices.end(), chunk.begin(), chunk.end());
+        }
+        return indices;
+    }
+
+    // Switches cached area/centre for every figure, see Figure::set_metrics_caching.
+    void set_metrics_caching(bool enabled)
+    requires requires (element_type& figure) { figure.set_metrics_caching(enabled); }
+    {
+        detach();
+        for (size_t i{0}; i < size(); ++i) {
             if constexpr (std::is_pointer_v<T>) {
-                total_square += static_cast<typename element_type::value_type>(*_body[i]);
+                _body->data[i]->set_metrics_caching(enabled);
             } else {
-                total_square += static_cast<typename element_type::value_type>(_body[i]);
+                _body->data[i].set_metrics_caching(enabled);
             }
         }
-        return total_square;
+    }
+
+    // In-place transforms of every figure, see Figure::translate, rotate, scale and transform.
+    void translate(const Point<scalar_type>& offset, size_t threads_number = 1)
+    requires requires (element_type& figure) { figure.translate(offset); }
+    {
+        for_each_figure(threads_number, [&offset](element_type& figure) { figure.translate(offset); });
+    }
+
+    // cos and sin are computed once for the whole array, not once per figure.
+    void rotate(scalar_type angle, const Point<scalar_type>& pivot = Point<scalar_type>(), size_t threads_number = 1)
+    requires requires (element_type& figure) { figure.rotate(angle, pivot); }
+    {
+        const scalar_type c = std::cos(angle);
+        const scalar_type s = std::sin(angle);
+        const Point<scalar_type> offset = similarity_offset(c, s, pivot);
+        if (similarity_invalid(c, s, offset)) {
+            throw std::invalid_argument("Invalid rotation");
+        }
+        for_each_figure(threads_number, [&](element_type& figure) { figure.apply_similarity(c, s, offset); });
+    }
+
+    void scale(scalar_type k, const Point<scalar_type>& pivot = Point<scalar_type>(), size_t threads_number = 1)
+    requires requires (element_type& figure) { figure.scale(k, pivot); }
+    {
+        if (std::abs(k) < Point<scalar_type>::eps) {
+            throw std::invalid_argument("Scale factor must not be zero");
+        }
+        for_each_figure(threads_number, [&](element_type& figure) { figure.scale(k, pivot); });
+    }
+
+    // Every figure is revalidated. If one of them becomes invalid the exception is rethrown,
+    // that figure is unchanged and the others may already be transformed.
+    void transform(scalar_type a, scalar_type b, scalar_type c, scalar_type d, const Point<scalar_type>& offset,
+            size_t threads_number = 1)
+    requires requires (element_type& figure) { figure.transform(a, b, c, d, offset); }
+    {
+        for_each_figure(threads_number, [&](element_type& figure) { figure.transform(a, b, c, d, offset); });
     }
 
     void remove(size_t index) {
-        for (size_t i{index}; i < _size - 1; ++i) {
-            _body[i] = _body[i + 1];
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        FIGURE_COUNT_N(remove_shifts, size() - 1 - index);
+        detach();
+        T *data = _body->data;
+        for (size_t i{index}; i < size() - 1; ++i) {
+            data[i] = std::move(data[i + 1]);
+        }
+        pop_back();
+    }
+
+    // O(1) removal that moves the last figure into the freed slot, so the order is not kept.
+    void swap_remove(size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        detach();
+        if (index != size() - 1) {
+            _body->data[index] = std::move(_body->data[size() - 1]);
+        }
+        pop_back();
+    }
+
+    // Removes every figure the predicate holds for in a single compacting pass.
+    // Keeps the order of the remaining figures and returns the number of removed ones.
+    template <typename Predicate>
+    size_t erase_if(Predicate predicate) {
+        return erase_indices([&](size_t i) { return predicate(std::as_const(_body->data[i])); });
+    }
+
+public:
+    // Indices of the figures equal to figure. Only figures with the same or an adjacent
+    // hash key are compared, see FigureHashKey.
+    std::vector<size_t> find_equal(const element_type& figure) const
+    requires requires (const element_type& a) { figure_hash_key(a); a == a; }
+    {
+        const FigureHashKey key = figure_hash_key(figure);
+        std::vector<size_t> indices;
+        for (size_t i{0}; i < size(); ++i) {
+            const FigureHashKey other = figure_hash_key(element(i));
+            if (other.vertices_number == key.vertices_number &&
+                    other.side_bucket >= key.side_bucket - 1 && other.side_bucket <= key.side_bucket + 1 &&
+                    element(i) == figure) {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+
+    // Groups of equal figures in expected O(n). A figure joins the group of the first
+    // earlier figure it is equal to, so groups and their members are in index order.
+    std::vector<std::vector<size_t>> group_by_equality() const
+    requires requires (const element_type& a) { figure_hash_key(a); a == a; }
+    {
+        const std::vector<size_t> leaders = equality_leaders();
+        std::vector<std::vector<size_t>> groups;
+        std::vector<size_t> group_of(size());
+        for (size_t i{0}; i < size(); ++i) {
+            if (leaders[i] == i) {
+                group_of[i] = groups.size();
+                groups.emplace_back();
+            }
+            groups[group_of[leaders[i]]].push_back(i);
+        }
+        return groups;
+    }
+
+    // Keeps the first figure of every group_by_equality() group and removes the rest,
+    // keeping the order. Returns the number of removed figures. Pointers are not deleted.
+    size_t dedup()
+    requires requires (const element_type& a) { figure_hash_key(a); a == a; }
+    {
+        const std::vector<size_t> leaders = equality_leaders();
+        return erase_indices([&leaders](size_t i) { return leaders[i] != i; });
+    }
+
+private:
+    std::shared_ptr<Storage> make_storage(size_t capacity) const {
+        return std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(_resource), _resource, capacity);
+    }
+
+    // New storage from resource holding copies of the elements of this body.
+    std::shared_ptr<Storage> copy_storage(std::pmr::memory_resource* resource, size_t capacity) const {
+        std::shared_ptr<Storage> storage = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(resource), resource, capacity);
+        allocator_type allocator(resource);
+        for (size_t i{0}; i < size(); ++i) {
+            std::allocator_traits<allocator_type>::construct(allocator, storage->data + i, std::as_const(_body->data[i]));
+            ++storage->size;
+        }
+        return storage;
+    }
+
+    // Whether this array is the only owner of its body. use_count() is a relaxed load, so
+    // the acquire fence pairs with the release in the other owners' shared_ptr destructors:
+    // their reads of the body happen before this array mutates it.
+    bool owns_body() const {
+        if (_body.use_count() > 1) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    // Gives this array its own copy of a body shared with other arrays. The shared body
+    // is only read, so the other owners are not affected.
+    void detach() {
+        if (_body && !owns_body()) {
+            FIGURE_COUNT(array_detaches);
+            _body = copy_storage(_resource, _body->capacity);
+        }
+    }
+
+    // Fills the empty storage with the elements of this body. They already belong to this
+    // array's resource, so they are relocated with plain moves. A shared body is copied instead.
+    void relocate_into(Storage& storage) {
+        if (!_body) {
+            return;
+        }
+        if (!owns_body()) {
+            FIGURE_COUNT(array_detaches);
+            allocator_type allocator(_resource);
+            for (size_t i{0}; i < size(); ++i) {
+                std::allocator_traits<allocator_type>::construct(allocator, storage.data + i, std::as_const(_body->data[i]));
+                ++storage.size;
+            }
+            return;
+        }
+        std::uninitialized_move_n(_body->data, _body->size, storage.data);
+        storage.size = _body->size;
+    }
+
+    void reallocate(size_t new_capacity) {
+        FIGURE_COUNT(array_reallocations);
+        std::shared_ptr<Storage> storage = make_storage(new_capacity);
+        relocate_into(*storage);
+        _body = std::move(storage);
+    }
+
+    void pop_back() {
+        --_body->size;
+        std::destroy_at(_body->data + _body->size);
+    }
+
+    // Compacts the array in one pass, dropping the indices remove_index holds for.
+    template <typename Predicate>
+    size_t erase_indices(Predicate remove_index) {
+        detach();
+        T *data = _body ? _body->data : nullptr;
+        size_t kept{0};
+        for (size_t i{0}; i < size(); ++i) {
+            if (!remove_index(i)) {
+                if (kept != i) {
+                    data[kept] = std::move(data[i]);
+                }
+                ++kept;
+            }
+        }
+        const size_t removed = size() - kept;
+        while (size() > kept) {
+            pop_back();
+        }
+        return removed;
+    }
+
+    // For every figure, the index of the first figure it is equal to (possibly itself).
+    // Leaders are hashed by key and looked up in the key's bucket and both neighbours.
+    std::vector<size_t> equality_leaders() const {
+        std::unordered_map<FigureHashKey, std::vector<size_t>, FigureHashKeyHash> buckets;
+        buckets.reserve(size());
+        std::vector<size_t> leaders(size());
+        for (size_t i{0}; i < size(); ++i) {
+            const FigureHashKey key = figure_hash_key(element(i));
+            leaders[i] = i;
+            for (int64_t offset{-1}; offset <= 1; ++offset) {
+                auto bucket = buckets.find(key.neighbour(offset));
+                if (bucket == buckets.end()) {
+                    continue;
+                }
+                for (size_t leader : bucket->second) {
+                    if (element(leader) == element(i)) {
+                        leaders[i] = std::min(leaders[i], leader);
+                        break;
+                    }
+                }
+            }
+            if (leaders[i] == i) {
+                buckets[key].push_back(i);
+            }
+        }
+        return leaders;
+    }
+
+    template <typename Func>
+    void for_each_figure(size_t threads_number, Func func) {
+        detach();
+        parallel_for_chunks(size(), threads_number, [&](size_t, size_t begin, size_t end) {
+            for (size_t i{begin}; i < end; ++i) {
+                func(element(i));
+            }
+        });
+    }
+
+    element_type& element(size_t index) {
+        if constexpr (std::is_pointer_v<T>) {
+            return *_body->data[index];
+        } else {
+            return _body->data[index];
+        }
+    }
+
+    const element_type& element(size_t index) const {
+        if constexpr (std::is_pointer_v<T>) {
+            return *_body->data[index];
+        } else {
+            return _body->data[index];
         }
-        --_size;
     }
 };
 
@@ -0,0 +1,22 @@
+#ifndef MY_ARRAY_FWD_H
+#define MY_ARRAY_FWD_H
+
+#include "./point.h"
+#include <iostream>
+#include <type_traits>
+#include <concepts>
+
+template<typename T>
+concept IsFigure = requires (T t, std::ostream& os, std::istream& is) {
+    { is >> t } -> std::same_as<std::istream&>;
+    { os << t } -> std::same_as<std::ostream&>;
+    { t.calc_centre() } -> std::same_as<Point<typename T::value_type>>;
+    { static_cast<typename T::value_type>(t) } -> std::convertible_to<typename T::value_type>;
+};
+
+// Declared here so figures can befriend MyArray without including it.
+template<typename T>
+requires IsFigure<T> || (std::is_pointer_v<T> && IsFigure<std::remove_pointer_t<T>>)
+class MyArray;
+
+#endif
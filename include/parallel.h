@@ -0,0 +1,84 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of elements in one chunk of parallel work. Chunk boundaries depend only on
+// the number of elements, so per-chunk results combined in chunk order are the same
+// for any number of threads.
+inline constexpr size_t parallel_chunk_size{4096};
+
+inline size_t parallel_chunks_number(size_t n) {
+    return (n + parallel_chunk_size - 1) / parallel_chunk_size;
+}
+
+inline size_t resolve_threads_number(size_t threads_number) {
+    if (threads_number == 0) {
+        threads_number = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    return threads_number;
+}
+
+// Calls func(task) for every task in [0, tasks_number), handing tasks out to the
+// threads one at a time. threads_number == 0 means one thread per hardware core.
+// The first exception thrown by func is rethrown on the calling thread.
+template <typename F>
+void parallel_for_tasks(size_t tasks_number, size_t threads_number, F func) {
+    threads_number = std::min(resolve_threads_number(threads_number), tasks_number);
+    if (threads_number <= 1) {
+        for (size_t task{0}; task < tasks_number; ++task) {
+            func(task);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_task{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        for (size_t task = next_task++; task < tasks_number; task = next_task++) {
+            try {
+                func(task);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next_task = tasks_number;
+            }
+        }
+    };
+
+    // If a thread cannot be started, the threads already running and the calling thread
+    // share the remaining tasks, so no joinable thread is left behind.
+    std::vector<std::thread> threads;
+    threads.reserve(threads_number - 1);
+    try {
+        for (size_t i{1}; i < threads_number; ++i) {
+            threads.emplace_back(worker);
+        }
+    } catch (...) {
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Calls func(chunk_index, begin, end) for every chunk of [0, n).
+template <typename F>
+void parallel_for_chunks(size_t n, size_t threads_number, F func) {
+    parallel_for_tasks(parallel_chunks_number(n), threads_number, [&](size_t chunk) {
+        func(chunk, chunk * parallel_chunk_size, std::min(n, (chunk + 1) * parallel_chunk_size));
+    });
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include <algorithm>
 #include <cmath>
 #include <concepts>
 #include <type_traits>
@@ -10,6 +11,35 @@
 template<typename T>
 concept Scalar = std::is_scalar_v<T> && std::floating_point<T>;
 
+// Comparison tolerances per precision. absolute bounds errors of values near zero,
+// relative bounds rounding errors that grow with the magnitude of the coordinates.
+template<Scalar T>
+struct Tolerance;
+
+template<>
+struct Tolerance<float> {
+    static constexpr float absolute{1e-4f};
+    static constexpr float relative{1e-5f};
+};
+
+template<>
+struct Tolerance<double> {
+    static constexpr double absolute{1e-6};
+    static constexpr double relative{1e-12};
+};
+
+template<>
+struct Tolerance<long double> {
+    static constexpr long double absolute{1e-6L};
+    static constexpr long double relative{1e-15L};
+};
+
+// |a - b| below the absolute tolerance plus the relative one scaled by the larger magnitude.
+template<Scalar T>
+bool approx_equal(T a, T b) {
+    return std::abs(a - b) < Tolerance<T>::absolute + Tolerance<T>::relative * std::max(std::abs(a), std::abs(b));
+}
+
 template<Scalar T>
 class Point final
 {
@@ -47,7 +77,8 @@ class Point final
     friend A scalar_product(const Point<A>& p1, const Point<A>& p2);
 
 public:
-    static constexpr T eps{1e-6};
+    static constexpr T eps{Tolerance<T>::absolute};
+    static constexpr T rel_eps{Tolerance<T>::relative};
 
 private:
     T _x{};
@@ -176,7 +207,7 @@ Point<T> operator*(T k, Point<T> right) {
 
 template<Scalar T>
 bool operator==(const Point<T>& left, const Point<T>& right) {
-    return std::abs(left._x - right._x) < Point<T>::eps && std::abs(left._y - right._y) < Point<T>::eps;
+    return approx_equal(left._x, right._x) && approx_equal(left._y, right._y);
 }
 
 template<Scalar T>
@@ -206,4 +237,19 @@ T scalar_product(const Point<T>& p1, const Point<T>& p2) {
     return p1._x * p2._x + p1._y * p2._y;
 }
 
+// Offset that makes p -> (c -s; s c) * p + offset keep pivot in place.
+template<Scalar T>
+Point<T> similarity_offset(T c, T s, const Point<T>& pivot) {
+    return pivot - Point<T>(c * pivot.get_x() - s * pivot.get_y(), s * pivot.get_x() + c * pivot.get_y());
+}
+
+// p -> (c -s; s c) * p + offset must be finite and must not collapse the figure, that is
+// its scale |(c, s)| must be at least eps, the bound scale() checks the factor against.
+// Written as what a valid transform satisfies, so NaN fails it.
+template<Scalar T>
+bool similarity_invalid(T c, T s, const Point<T>& offset) {
+    return !(std::isfinite(c) && std::isfinite(s) && std::isfinite(offset.get_x()) && std::isfinite(offset.get_y())
+            && c * c + s * s >= Point<T>::eps * Point<T>::eps);
+}
+
 #endif
\ No newline at end of file
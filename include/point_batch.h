@@ -0,0 +1,476 @@
+#ifndef POINT_BATCH_H
+#define POINT_BATCH_H
+
+#include "./point.h"
+#include <span>
+#include <cmath>
+#include <exception>
+#include <type_traits>
+#include <concepts>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define POINT_BATCH_X86
+#include <immintrin.h>
+#endif
+
+// Batch versions of the Point<T> operations. Points are processed as an interleaved
+// array of coordinates (x0, y0, x1, y1, ...), so the kernels rely on Point<T> being
+// exactly two packed scalars.
+//
+// The portable kernels are plain loops the compiler vectorizes with the baseline
+// instruction set (SSE2 on x86-64). On x86 the AVX2 kernels are selected at runtime.
+
+namespace point_batch_detail {
+
+template <Scalar T>
+const T* coords(std::span<const Point<T>> points) {
+    static_assert(sizeof(Point<T>) == 2 * sizeof(T), "Point must consist of two packed coordinates");
+    return reinterpret_cast<const T*>(points.data());
+}
+
+template <Scalar T>
+T* coords(std::span<Point<T>> points) {
+    static_assert(sizeof(Point<T>) == 2 * sizeof(T), "Point must consist of two packed coordinates");
+    return reinterpret_cast<T*>(points.data());
+}
+
+inline void check_sizes(size_t a, size_t b) {
+    if (a != b) {
+        throw std::invalid_argument("Batch sizes do not match");
+    }
+}
+
+template <Scalar T>
+void add_portable(T* dst, const T* src, size_t n) {
+    for (size_t i{0}; i < 2 * n; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+template <Scalar T>
+void sub_portable(T* dst, const T* src, size_t n) {
+    for (size_t i{0}; i < 2 * n; ++i) {
+        dst[i] -= src[i];
+    }
+}
+
+template <Scalar T>
+void scale_portable(T* dst, T k, size_t n) {
+    for (size_t i{0}; i < 2 * n; ++i) {
+        dst[i] *= k;
+    }
+}
+
+template <Scalar T>
+void rotate_portable(T* dst, T c, T s, size_t n) {
+    for (size_t i{0}; i < n; ++i) {
+        T x = dst[2 * i];
+        T y = dst[2 * i + 1];
+        dst[2 * i] = x * c - y * s;
+        dst[2 * i + 1] = x * s + y * c;
+    }
+}
+
+template <Scalar T>
+void affine_portable(T* dst, T a, T b, T c, T d, T tx, T ty, size_t n) {
+    for (size_t i{0}; i < n; ++i) {
+        T x = dst[2 * i];
+        T y = dst[2 * i + 1];
+        dst[2 * i] = a * x + b * y + tx;
+        dst[2 * i + 1] = c * x + d * y + ty;
+    }
+}
+
+template <Scalar T>
+void dot_portable(const T* a, const T* b, T* out, size_t n) {
+    for (size_t i{0}; i < n; ++i) {
+        out[i] = a[2 * i] * b[2 * i] + a[2 * i + 1] * b[2 * i + 1];
+    }
+}
+
+template <Scalar T>
+void cross_portable(const T* a, const T* b, T* out, size_t n) {
+    for (size_t i{0}; i < n; ++i) {
+        out[i] = a[2 * i] * b[2 * i + 1] - b[2 * i] * a[2 * i + 1];
+    }
+}
+
+template <Scalar T>
+void length_portable(const T* a, T* out, size_t n) {
+    for (size_t i{0}; i < n; ++i) {
+        out[i] = std::sqrt(a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1]);
+    }
+}
+
+#ifdef POINT_BATCH_X86
+
+inline bool cpu_has_avx2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+// Each kernel handles whole registers and leaves the tail to the portable loop.
+// Returns the number of processed points.
+
+__attribute__((target("avx2")))
+inline size_t add_avx2(double* dst, const double* src, size_t n) {
+    size_t i{0};
+    for (; i + 2 <= n; i += 2) {
+        __m256d d = _mm256_loadu_pd(dst + 2 * i);
+        _mm256_storeu_pd(dst + 2 * i, _mm256_add_pd(d, _mm256_loadu_pd(src + 2 * i)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t add_avx2(float* dst, const float* src, size_t n) {
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        __m256 d = _mm256_loadu_ps(dst + 2 * i);
+        _mm256_storeu_ps(dst + 2 * i, _mm256_add_ps(d, _mm256_loadu_ps(src + 2 * i)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t sub_avx2(double* dst, const double* src, size_t n) {
+    size_t i{0};
+    for (; i + 2 <= n; i += 2) {
+        __m256d d = _mm256_loadu_pd(dst + 2 * i);
+        _mm256_storeu_pd(dst + 2 * i, _mm256_sub_pd(d, _mm256_loadu_pd(src + 2 * i)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t sub_avx2(float* dst, const float* src, size_t n) {
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        __m256 d = _mm256_loadu_ps(dst + 2 * i);
+        _mm256_storeu_ps(dst + 2 * i, _mm256_sub_ps(d, _mm256_loadu_ps(src + 2 * i)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t scale_avx2(double* dst, double k, size_t n) {
+    const __m256d kk = _mm256_set1_pd(k);
+    size_t i{0};
+    for (; i + 2 <= n; i += 2) {
+        _mm256_storeu_pd(dst + 2 * i, _mm256_mul_pd(_mm256_loadu_pd(dst + 2 * i), kk));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t scale_avx2(float* dst, float k, size_t n) {
+    const __m256 kk = _mm256_set1_ps(k);
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_ps(dst + 2 * i, _mm256_mul_ps(_mm256_loadu_ps(dst + 2 * i), kk));
+    }
+    return i;
+}
+
+// (x, y) -> (x c - y s, y c + x s): v * c + swap(v) * (-s, s)
+__attribute__((target("avx2")))
+inline size_t rotate_avx2(double* dst, double c, double s, size_t n) {
+    const __m256d cc = _mm256_set1_pd(c);
+    const __m256d ss = _mm256_setr_pd(-s, s, -s, s);
+    size_t i{0};
+    for (; i + 2 <= n; i += 2) {
+        __m256d v = _mm256_loadu_pd(dst + 2 * i);
+        __m256d swapped = _mm256_permute_pd(v, 0b0101);
+        _mm256_storeu_pd(dst + 2 * i, _mm256_add_pd(_mm256_mul_pd(v, cc), _mm256_mul_pd(swapped, ss)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t rotate_avx2(float* dst, float c, float s, size_t n) {
+    const __m256 cc = _mm256_set1_ps(c);
+    const __m256 ss = _mm256_setr_ps(-s, s, -s, s, -s, s, -s, s);
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        __m256 v = _mm256_loadu_ps(dst + 2 * i);
+        __m256 swapped = _mm256_permute_ps(v, 0b10110001);
+        _mm256_storeu_ps(dst + 2 * i, _mm256_add_ps(_mm256_mul_ps(v, cc), _mm256_mul_ps(swapped, ss)));
+    }
+    return i;
+}
+
+// (x, y) -> (a x + b y + tx, c x + d y + ty): v * (a, d) + swap(v) * (b, c) + (tx, ty)
+__attribute__((target("avx2")))
+inline size_t affine_avx2(double* dst, double a, double b, double c, double d, double tx, double ty, size_t n) {
+    const __m256d diag = _mm256_setr_pd(a, d, a, d);
+    const __m256d anti = _mm256_setr_pd(b, c, b, c);
+    const __m256d offset = _mm256_setr_pd(tx, ty, tx, ty);
+    size_t i{0};
+    for (; i + 2 <= n; i += 2) {
+        __m256d v = _mm256_loadu_pd(dst + 2 * i);
+        __m256d swapped = _mm256_permute_pd(v, 0b0101);
+        __m256d r = _mm256_add_pd(_mm256_mul_pd(v, diag), _mm256_mul_pd(swapped, anti));
+        _mm256_storeu_pd(dst + 2 * i, _mm256_add_pd(r, offset));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t affine_avx2(float* dst, float a, float b, float c, float d, float tx, float ty, size_t n) {
+    const __m256 diag = _mm256_setr_ps(a, d, a, d, a, d, a, d);
+    const __m256 anti = _mm256_setr_ps(b, c, b, c, b, c, b, c);
+    const __m256 offset = _mm256_setr_ps(tx, ty, tx, ty, tx, ty, tx, ty);
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        __m256 v = _mm256_loadu_ps(dst + 2 * i);
+        __m256 swapped = _mm256_permute_ps(v, 0b10110001);
+        __m256 r = _mm256_add_ps(_mm256_mul_ps(v, diag), _mm256_mul_ps(swapped, anti));
+        _mm256_storeu_ps(dst + 2 * i, _mm256_add_ps(r, offset));
+    }
+    return i;
+}
+
+// Pairwise horizontal sums of two products restored to point order.
+__attribute__((target("avx2")))
+inline __m256d pair_hadd(__m256d p0, __m256d p1) {
+    return _mm256_permute4x64_pd(_mm256_hadd_pd(p0, p1), 0b11011000);
+}
+
+__attribute__((target("avx2")))
+inline __m256d pair_hsub(__m256d p0, __m256d p1) {
+    return _mm256_permute4x64_pd(_mm256_hsub_pd(p0, p1), 0b11011000);
+}
+
+__attribute__((target("avx2")))
+inline __m256 pair_hadd(__m256 p0, __m256 p1) {
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_hadd_ps(p0, p1)), 0b11011000));
+}
+
+__attribute__((target("avx2")))
+inline __m256 pair_hsub(__m256 p0, __m256 p1) {
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_hsub_ps(p0, p1)), 0b11011000));
+}
+
+__attribute__((target("avx2")))
+inline size_t dot_avx2(const double* a, const double* b, double* out, size_t n) {
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        __m256d p0 = _mm256_mul_pd(_mm256_loadu_pd(a + 2 * i), _mm256_loadu_pd(b + 2 * i));
+        __m256d p1 = _mm256_mul_pd(_mm256_loadu_pd(a + 2 * i + 4), _mm256_loadu_pd(b + 2 * i + 4));
+        _mm256_storeu_pd(out + i, pair_hadd(p0, p1));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t dot_avx2(const float* a, const float* b, float* out, size_t n) {
+    size_t i{0};
+    for (; i + 8 <= n; i += 8) {
+        __m256 p0 = _mm256_mul_ps(_mm256_loadu_ps(a + 2 * i), _mm256_loadu_ps(b + 2 * i));
+        __m256 p1 = _mm256_mul_ps(_mm256_loadu_ps(a + 2 * i + 8), _mm256_loadu_ps(b + 2 * i + 8));
+        _mm256_storeu_ps(out + i, pair_hadd(p0, p1));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t cross_avx2(const double* a, const double* b, double* out, size_t n) {
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        __m256d b0 = _mm256_permute_pd(_mm256_loadu_pd(b + 2 * i), 0b0101);
+        __m256d b1 = _mm256_permute_pd(_mm256_loadu_pd(b + 2 * i + 4), 0b0101);
+        __m256d p0 = _mm256_mul_pd(_mm256_loadu_pd(a + 2 * i), b0);
+        __m256d p1 = _mm256_mul_pd(_mm256_loadu_pd(a + 2 * i + 4), b1);
+        _mm256_storeu_pd(out + i, pair_hsub(p0, p1));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t cross_avx2(const float* a, const float* b, float* out, size_t n) {
+    size_t i{0};
+    for (; i + 8 <= n; i += 8) {
+        __m256 b0 = _mm256_permute_ps(_mm256_loadu_ps(b + 2 * i), 0b10110001);
+        __m256 b1 = _mm256_permute_ps(_mm256_loadu_ps(b + 2 * i + 8), 0b10110001);
+        __m256 p0 = _mm256_mul_ps(_mm256_loadu_ps(a + 2 * i), b0);
+        __m256 p1 = _mm256_mul_ps(_mm256_loadu_ps(a + 2 * i + 8), b1);
+        _mm256_storeu_ps(out + i, pair_hsub(p0, p1));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t length_avx2(const double* a, double* out, size_t n) {
+    size_t i{0};
+    for (; i + 4 <= n; i += 4) {
+        __m256d v0 = _mm256_loadu_pd(a + 2 * i);
+        __m256d v1 = _mm256_loadu_pd(a + 2 * i + 4);
+        __m256d sq = pair_hadd(_mm256_mul_pd(v0, v0), _mm256_mul_pd(v1, v1));
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(sq));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t length_avx2(const float* a, float* out, size_t n) {
+    size_t i{0};
+    for (; i + 8 <= n; i += 8) {
+        __m256 v0 = _mm256_loadu_ps(a + 2 * i);
+        __m256 v1 = _mm256_loadu_ps(a + 2 * i + 8);
+        __m256 sq = pair_hadd(_mm256_mul_ps(v0, v0), _mm256_mul_ps(v1, v1));
+        _mm256_storeu_ps(out + i, _mm256_sqrt_ps(sq));
+    }
+    return i;
+}
+
+template <typename T>
+concept Avx2Scalar = std::same_as<T, float> || std::same_as<T, double>;
+
+#endif
+
+} // namespace point_batch_detail
+
+// dst[i] += src[i]
+template <Scalar T>
+void batch_add(std::span<Point<T>> dst, std::span<const Point<T>> src) {
+    using namespace point_batch_detail;
+    check_sizes(dst.size(), src.size());
+    T *d = coords(dst);
+    const T *s = coords(src);
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = add_avx2(d, s, dst.size());
+        }
+    }
+#endif
+    add_portable(d + 2 * done, s + 2 * done, dst.size() - done);
+}
+
+// dst[i] -= src[i]
+template <Scalar T>
+void batch_sub(std::span<Point<T>> dst, std::span<const Point<T>> src) {
+    using namespace point_batch_detail;
+    check_sizes(dst.size(), src.size());
+    T *d = coords(dst);
+    const T *s = coords(src);
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = sub_avx2(d, s, dst.size());
+        }
+    }
+#endif
+    sub_portable(d + 2 * done, s + 2 * done, dst.size() - done);
+}
+
+// dst[i] *= k
+template <Scalar T>
+void batch_scale(std::span<Point<T>> dst, T k) {
+    using namespace point_batch_detail;
+    T *d = coords(dst);
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = scale_avx2(d, k, dst.size());
+        }
+    }
+#endif
+    scale_portable(d + 2 * done, k, dst.size() - done);
+}
+
+// dst[i] = dst[i].rotate(angle)
+template <Scalar T>
+void batch_rotate(std::span<Point<T>> dst, T angle) {
+    using namespace point_batch_detail;
+    T *d = coords(dst);
+    const T c = std::cos(angle);
+    const T s = std::sin(angle);
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = rotate_avx2(d, c, s, dst.size());
+        }
+    }
+#endif
+    rotate_portable(d + 2 * done, c, s, dst.size() - done);
+}
+
+// dst[i] = (a b; c d) * dst[i] + offset
+template <Scalar T>
+void batch_affine(std::span<Point<T>> dst, T a, T b, T c, T d, const Point<T>& offset) {
+    using namespace point_batch_detail;
+    T *p = coords(dst);
+    const T tx = offset.get_x();
+    const T ty = offset.get_y();
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = affine_avx2(p, a, b, c, d, tx, ty, dst.size());
+        }
+    }
+#endif
+    affine_portable(p + 2 * done, a, b, c, d, tx, ty, dst.size() - done);
+}
+
+// out[i] = scalar_product(a[i], b[i])
+template <Scalar T>
+void batch_scalar_product(std::span<const Point<T>> a, std::span<const Point<T>> b, std::span<T> out) {
+    using namespace point_batch_detail;
+    check_sizes(a.size(), b.size());
+    check_sizes(a.size(), out.size());
+    const T *pa = coords(a);
+    const T *pb = coords(b);
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = dot_avx2(pa, pb, out.data(), a.size());
+        }
+    }
+#endif
+    dot_portable(pa + 2 * done, pb + 2 * done, out.data() + done, a.size() - done);
+}
+
+// out[i] = vector_product_factor(a[i], b[i])
+template <Scalar T>
+void batch_vector_product_factor(std::span<const Point<T>> a, std::span<const Point<T>> b, std::span<T> out) {
+    using namespace point_batch_detail;
+    check_sizes(a.size(), b.size());
+    check_sizes(a.size(), out.size());
+    const T *pa = coords(a);
+    const T *pb = coords(b);
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = cross_avx2(pa, pb, out.data(), a.size());
+        }
+    }
+#endif
+    cross_portable(pa + 2 * done, pb + 2 * done, out.data() + done, a.size() - done);
+}
+
+// out[i] = a[i].length()
+template <Scalar T>
+void batch_length(std::span<const Point<T>> a, std::span<T> out) {
+    using namespace point_batch_detail;
+    check_sizes(a.size(), out.size());
+    const T *pa = coords(a);
+    size_t done{0};
+#ifdef POINT_BATCH_X86
+    if constexpr (Avx2Scalar<T>) {
+        if (cpu_has_avx2()) {
+            done = length_avx2(pa, out.data(), a.size());
+        }
+    }
+#endif
+    length_portable(pa + 2 * done, out.data() + done, a.size() - done);
+}
+
+#endif
@@ -5,7 +5,10 @@
 #include <type_traits>
 #include <concepts>
 #include <vector>
+#include <string>
 #include <numbers>
+#include <array>
+#include <span>
 
 template <Scalar T>
 std::vector<Point<T>> gen_regular_polygon_points(int v_count, T start_x, T start_y, T start_angle, T side) {
@@ -18,39 +21,226 @@ std::vector<Point<T>> gen_regular_polygon_points(int v_count, T start_x, T start
     return point_vector;
 }
 
+namespace regular_polygon_detail {
+
+// Taylor series for |x| <= pi, evaluated in long double so the tables are exact in T.
+constexpr long double constexpr_sin(long double x) {
+    long double term = x;
+    long double sum = x;
+    for (int n{1}; n < 30; ++n) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr long double constexpr_cos(long double x) {
+    long double term = 1;
+    long double sum = 1;
+    for (int n{1}; n < 30; ++n) {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+} // namespace regular_polygon_detail
+
+// Vertices of the polygon gen_regular_polygon_points builds for start (0, 0), angle 0
+// and side 1, as { x, y } pairs. Generated at compile time.
+template <Scalar T, int V>
+requires (V >= 3)
+inline constexpr std::array<std::array<T, 2>, V> regular_polygon_unit_points = [] {
+    using namespace regular_polygon_detail;
+    std::array<std::array<T, 2>, V> points{};
+    long double x{0};
+    long double y{0};
+    for (int k{0}; k + 1 < V; ++k) {
+        long double angle = 2 * std::numbers::pi_v<long double> * k / V;
+        if (angle > std::numbers::pi_v<long double>) {
+            angle -= 2 * std::numbers::pi_v<long double>;
+        }
+        x += constexpr_sin(angle);
+        y += constexpr_cos(angle);
+        points[k + 1] = { static_cast<T>(x), static_cast<T>(y) };
+    }
+    return points;
+}();
+
+// { cos, sin } of 2*pi*k/V for k in [0, V). Generated at compile time.
+template <Scalar T, int V>
+requires (V >= 3)
+inline constexpr std::array<std::array<T, 2>, V> regular_polygon_unit_circle = [] {
+    using namespace regular_polygon_detail;
+    std::array<std::array<T, 2>, V> directions{};
+    for (int k{0}; k < V; ++k) {
+        long double angle = 2 * std::numbers::pi_v<long double> * k / V;
+        if (angle > std::numbers::pi_v<long double>) {
+            angle -= 2 * std::numbers::pi_v<long double>;
+        }
+        directions[k] = { static_cast<T>(constexpr_cos(angle)), static_cast<T>(constexpr_sin(angle)) };
+    }
+    return directions;
+}();
+
+// Same polygon as gen_regular_polygon_points(V, ...), built from the unit table with
+// one sin/cos pair per polygon.
+template <Scalar T, int V>
+std::array<Point<T>, V> gen_regular_polygon_points(T start_x, T start_y, T start_angle, T side) {
+    const T cos_ = side * std::cos(start_angle);
+    const T sin_ = side * std::sin(start_angle);
+    std::array<Point<T>, V> points;
+    for (int i{0}; i < V; ++i) {
+        const auto &[x, y] = regular_polygon_unit_points<T, V>[i];
+        points[i] = Point<T>(start_x + x * cos_ - y * sin_, start_y + x * sin_ + y * cos_);
+    }
+    return points;
+}
+
+template <Scalar T>
+T regular_polygon_square(int v_count, T side) {
+    T perimeter = v_count * side;
+    T small_radius = side / std::tan(std::numbers::pi / v_count);
+    return 0.5 * perimeter * small_radius;
+}
+
+namespace regular_polygon_detail {
+
+// turn_cos and turn_sin are the cosine and sine of 2*pi/count.
+template <Scalar T>
+bool regular_polygon_invalid(const Point<T>* points, size_t count, T turn_cos, T turn_sin) {
+    if (count < 3 || convex_polygon_invalid(points, count)) {
+        return true;
+    }
+    Point<T> v1 = points[1] - points[0];
+    const T side2 = scalar_product(v1, v1);
+    if (!(side2 >= Point<T>::eps * Point<T>::eps)) {
+        return true;
+    }
+    const T magnitude = std::max(std::abs(points[0].get_x()), std::abs(points[0].get_y()));
+    const T tolerance = Point<T>::eps * side2 + 8 * Point<T>::rel_eps * magnitude * std::sqrt(side2);
+    for (size_t i{0}; i < count; ++i) {
+        Point<T> v2 = points[(i + 2) % count] - points[(i + 1) % count];
+        if (!(std::abs(scalar_product(v2, v2) - side2) <= tolerance &&
+                std::abs(scalar_product(v1, v2) - turn_cos * side2) <= tolerance &&
+                std::abs(vector_product_factor(v1, v2) + turn_sin * side2) <= tolerance)) {
+            return true;
+        }
+        v1 = v2;
+    }
+    return false;
+}
+
+} // namespace regular_polygon_detail
+
+// Every edge must have the length of the first one and turn clockwise from the previous
+// edge by exactly 2*pi/V. Compared through dot and cross products scaled by the
+// squared side, so the check needs no sqrt per edge, no trig and no allocation: the
+// turn comes from the compile-time regular_polygon_unit_circle table.
+// The tolerance also grows with the coordinate magnitude, since edge vectors of
+// far-away figures carry the rounding error of their coordinates (matters for float).
+// Includes convex_polygon_invalid, so this is the whole rule every regular polygon
+// type, RegularPolygon included, validates with.
+template <Scalar T, int V>
+bool regular_polygon_invalid(const Point<T>* points) {
+    if constexpr (V < 3) {
+        return true;
+    } else {
+        const auto &[turn_cos, turn_sin] = regular_polygon_unit_circle<T, V>[1];
+        return regular_polygon_detail::regular_polygon_invalid(points, V, turn_cos, turn_sin);
+    }
+}
+
+// Same rule for a vertex count only known at run time, at the cost of one cos/sin pair.
+template <Scalar T>
+bool regular_polygon_invalid(const Point<T>* points, size_t count) {
+    if (count < 3) {
+        return true;
+    }
+    const T angle = 2 * std::numbers::pi_v<T> / count;
+    return regular_polygon_detail::regular_polygon_invalid(points, count, std::cos(angle), std::sin(angle));
+}
+
+// Validates figures stored back to back, V points each, and writes one flag per figure.
+// Returns the number of valid figures.
+template <Scalar T, int V>
+size_t validate_regular_polygons(std::span<const Point<T>> points, std::span<bool> valid) {
+    if (points.size() != valid.size() * V) {
+        throw std::invalid_argument("Number of points does not match the number of figures");
+    }
+    size_t valid_number{0};
+    for (size_t i{0}; i < valid.size(); ++i) {
+        valid[i] = !regular_polygon_invalid<T, V>(points.data() + i * V);
+        valid_number += valid[i];
+    }
+    return valid_number;
+}
+
+inline std::string regular_polygon_name(int v_count) {
+    switch (v_count) {
+    case 3:
+        return "Triangle";
+    case 6:
+        return "Hexagone";
+    case 8:
+        return "Octagon";
+    default:
+        return "RegularPolygon(" + std::to_string(v_count) + ")";
+    }
+}
+
+inline void print_regular_polygon_name(std::ostream& os, int v_count) {
+    os << regular_polygon_name(v_count) << ": ";
+}
+
 template <Scalar T, int V>
 class RegularPolygon : public Figure<T>
 {
+public:
+    using allocator_type = typename Figure<T>::allocator_type;
+    static constexpr int vertices_number = V;
+
+private:
+    mutable MetricCache<T> _side_cache;
+
 public:
     RegularPolygon() :
         Figure<T>(gen_regular_polygon_points<T>(V, 0, 0, 0, 1))
     {
     }
 
-    RegularPolygon(const std::vector<Point<T>>& points) :
-        Figure<T>(points)
+    explicit RegularPolygon(const allocator_type& allocator) :
+        Figure<T>(gen_regular_polygon_points<T>(V, 0, 0, 0, 1), allocator)
     {
-        if (points.size() != V) {
-            throw std::invalid_argument("Invalid vertices number");
-        }
     }
 
-    RegularPolygon(const std::initializer_list<Point<T>>& points) :
-        Figure<T>(points)
-    {
-        if (points.size() != V) {
-            throw std::invalid_argument("Invalid vertices number");
-        }
-    }
+    // The points are checked once, with the regular rule, before Figure copies them.
+    RegularPolygon(const std::vector<Point<T>>& points, const allocator_type& allocator = {}) :
+        Figure<T>(typename Figure<T>::validated_points_tag{}, checked_points(points.data(), points.size()),
+                points.size(), allocator)
+    {}
+
+    RegularPolygon(const std::initializer_list<Point<T>>& points, const allocator_type& allocator = {}) :
+        Figure<T>(typename Figure<T>::validated_points_tag{}, checked_points(points.begin(), points.size()),
+                points.size(), allocator)
+    {}
 
     RegularPolygon(const RegularPolygon<T, V>& other) :
         Figure<T>(other)
     {}
 
+    RegularPolygon(const RegularPolygon<T, V>& other, const allocator_type& allocator) :
+        Figure<T>(other, allocator)
+    {}
+
     RegularPolygon(RegularPolygon<T, V>&& other) noexcept :
         Figure<T>(std::move(other))
     {}
 
+    RegularPolygon(RegularPolygon<T, V>&& other, const allocator_type& allocator) :
+        Figure<T>(std::move(other), allocator)
+    {}
+
     RegularPolygon<T, V>& operator=(const Figure<T>& other) override {
         const RegularPolygon<T, V> *ptr = dynamic_cast<const RegularPolygon<T, V>*>(&other);
         if (!ptr) {
@@ -65,17 +255,21 @@ public:
         return *this;
     }
 
-    RegularPolygon<T, V>& operator=(RegularPolygon<T, V>&& other) noexcept {
-        if (this != &other) {
-            this->_vertices_number = other._vertices_number;
-            this->_points = std::move(other._points);
-            other._vertices_number = 0;
-        }
+    RegularPolygon<T, V>& operator=(RegularPolygon<T, V>&& other) {
+        this->move_assign(other);
         return *this;
     }
 
     ~RegularPolygon() noexcept = default;
 
+public:
+    T side_length() const {
+        if (!this->_metrics_caching) {
+            return (this->_points[1] - this->_points[0]).length();
+        }
+        return _side_cache.get([this] { return (this->_points[1] - this->_points[0]).length(); });
+    }
+
 public:
     bool operator==(const Figure<T>& other) const override {
         const RegularPolygon<T, V>* ptr = dynamic_cast<const RegularPolygon<T, V>*>(&other);
@@ -88,45 +282,40 @@ public:
 
 protected:
     void print(std::ostream& os) const override {
-        switch (V) {
-        case 3:
-            os << "Triangle: ";
-            break;
-        case 6:
-            os << "Hexagone: ";
-            break;
-        case 8:
-            os << "Octagon: ";
-            break;
-        default:
-            os << "RegularPolygon(" << V << "): ";
-            break;
-        }
+        print_regular_polygon_name(os, V);
         Figure<T>::print(os);
     }
 
     T square() const override {
-        T side = (this->_points[1] - this->_points[0]).length();
-        T perimeter = this->_vertices_number * side;
-        T small_radius = side / std::tan(std::numbers::pi / this->_vertices_number);
-        return 0.5 * perimeter * small_radius;
+        return regular_polygon_square<T>(this->_vertices_number, side_length());
+    }
+
+    void invalidate_metrics() const override {
+        Figure<T>::invalidate_metrics();
+        _side_cache.reset();
     }
 
 protected:
     bool sides_invalid(const std::vector<Point<T>>& points) override {
-        if (points.size() != V || Figure<T>::sides_invalid(points)) {
-            return true;
+        return points.size() != V || regular_polygon_invalid<T, V>(points.data());
+    }
+
+private:
+    // Returns points if they form a valid polygon, throws otherwise.
+    static const Point<T>* checked_points(const Point<T>* points, size_t count) {
+        if (count != V) {
+            throw std::invalid_argument("Invalid vertices number");
+        }
+        bool invalid;
+        {
+            FIGURE_TIME(validation);
+            invalid = regular_polygon_invalid<T, V>(points);
         }
-        double need_angle = std::numbers::pi - std::numbers::pi * (points.size() - 2) / points.size();
-        for (size_t i{0}; i < points.size(); ++i) {
-            Point<T> v1 = points[(i + 1) % points.size()] - points[i];
-            Point<T> v2 = points[(i + 2) % points.size()] - points[(i + 1) % points.size()];
-            T angle = v1.angle_to(v2);
-            if (std::abs(need_angle - angle) > Point<T>::eps) {
-                return true;
-            }
+        if (invalid) {
+            FIGURE_COUNT(validation_rejects);
+            throw std::invalid_argument("Invalid sides");
         }
-        return false;
+        return points;
     }
 };
 
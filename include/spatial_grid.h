@@ -0,0 +1,202 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "./point.h"
+#include "./my_array.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid over figure centres. Each id is stored in the cell containing its
+// centre, so window and radius queries only look at the cells they overlap.
+template <Scalar T>
+class SpatialGrid
+{
+public:
+    using value_type = T;
+
+private:
+    struct Entry {
+        size_t id;
+        Point<T> centre;
+    };
+
+    struct CellKey {
+        int64_t x;
+        int64_t y;
+
+        bool operator==(const CellKey& other) const {
+            return x == other.x && y == other.y;
+        }
+    };
+
+    struct CellKeyHash {
+        size_t operator()(const CellKey& key) const {
+            size_t h = std::hash<int64_t>{}(key.x);
+            return h ^ (std::hash<int64_t>{}(key.y) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        }
+    };
+
+private:
+    T _cell_size;
+    std::unordered_map<CellKey, std::vector<Entry>, CellKeyHash> _cells;
+    std::unordered_map<size_t, Point<T>> _centres;
+
+public:
+    explicit SpatialGrid(T cell_size) :
+        _cell_size(cell_size)
+    {
+        if (!(cell_size > 0)) {
+            throw std::invalid_argument("Cell size must be positive");
+        }
+    }
+
+public:
+    size_t size() const {
+        return _centres.size();
+    }
+
+    T get_cell_size() const {
+        return _cell_size;
+    }
+
+    bool contains(size_t id) const {
+        return _centres.find(id) != _centres.end();
+    }
+
+    // Inserts a new id or moves an existing one to the new centre.
+    void insert(size_t id, const Point<T>& centre) {
+        if (!std::isfinite(centre.get_x()) || !std::isfinite(centre.get_y())) {
+            throw std::invalid_argument("Centre must be finite");
+        }
+        remove(id);
+        _centres.emplace(id, centre);
+        _cells[cell_key(cell_index(centre.get_x()), cell_index(centre.get_y()))].push_back(Entry{id, centre});
+    }
+
+    bool remove(size_t id) {
+        auto found = _centres.find(id);
+        if (found == _centres.end()) {
+            return false;
+        }
+        const Point<T> &centre = found->second;
+        auto cell = _cells.find(cell_key(cell_index(centre.get_x()), cell_index(centre.get_y())));
+        std::vector<Entry> &entries = cell->second;
+        auto position = std::find_if(entries.begin(), entries.end(), [id](const Entry& entry) {
+            return entry.id == id;
+        });
+        *position = entries.back();
+        entries.pop_back();
+        if (entries.empty()) {
+            _cells.erase(cell);
+        }
+        _centres.erase(found);
+        return true;
+    }
+
+    void clear() {
+        _cells.clear();
+        _centres.clear();
+    }
+
+    // Ids whose centres lie in the closed rectangle [min, max], sorted ascending.
+    std::vector<size_t> query_window(const Point<T>& min, const Point<T>& max) const {
+        std::vector<size_t> result;
+        for_each_candidate(min, max, [&](size_t id, const Point<T>& centre) {
+            if (centre.get_x() >= min.get_x() && centre.get_x() <= max.get_x() &&
+                    centre.get_y() >= min.get_y() && centre.get_y() <= max.get_y()) {
+                result.push_back(id);
+            }
+        });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Ids whose centres are at most radius away from centre, sorted ascending.
+    std::vector<size_t> query_radius(const Point<T>& centre, T radius) const {
+        std::vector<size_t> result;
+        const Point<T> offset(radius, radius);
+        const T radius2 = radius * radius;
+        for_each_candidate(centre - offset, centre + offset, [&](size_t id, const Point<T>& p) {
+            Point<T> d = p - centre;
+            if (scalar_product(d, d) <= radius2) {
+                result.push_back(id);
+            }
+        });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    // Indices beyond +-2^62 share the end cells, so the cast stays defined and far
+    // coordinates (or NaN query bounds) cannot overflow the window arithmetic. Queries
+    // test the stored centres themselves, so shared cells only cost extra candidates.
+    int64_t cell_index(T coord) const {
+        constexpr double limit = 0x1p62;
+        const double index = std::floor(static_cast<double>(coord) / static_cast<double>(_cell_size));
+        if (!(index < limit)) {
+            return static_cast<int64_t>(limit);
+        }
+        if (index <= -limit) {
+            return -static_cast<int64_t>(limit);
+        }
+        return static_cast<int64_t>(index);
+    }
+
+    static CellKey cell_key(int64_t cx, int64_t cy) {
+        return CellKey{cx, cy};
+    }
+
+    // Visits the ids of every cell overlapping [min, max]. Falls back to the occupied
+    // cells when the window covers more cells than are occupied.
+    template <typename F>
+    void for_each_candidate(const Point<T>& min, const Point<T>& max, F func) const {
+        if (min.get_x() > max.get_x() || min.get_y() > max.get_y()) {
+            return;
+        }
+        const int64_t x0 = cell_index(min.get_x());
+        const int64_t x1 = cell_index(max.get_x());
+        const int64_t y0 = cell_index(min.get_y());
+        const int64_t y1 = cell_index(max.get_y());
+        const double window_cells = (static_cast<double>(x1) - static_cast<double>(x0) + 1) *
+                (static_cast<double>(y1) - static_cast<double>(y0) + 1);
+        if (window_cells > static_cast<double>(_cells.size())) {
+            for (const auto &[key, entries] : _cells) {
+                for (const auto &entry : entries) {
+                    func(entry.id, entry.centre);
+                }
+            }
+            return;
+        }
+        for (int64_t cx{x0}; cx <= x1; ++cx) {
+            for (int64_t cy{y0}; cy <= y1; ++cy) {
+                auto cell = _cells.find(cell_key(cx, cy));
+                if (cell == _cells.end()) {
+                    continue;
+                }
+                for (const auto &entry : cell->second) {
+                    func(entry.id, entry.centre);
+                }
+            }
+        }
+    }
+};
+
+// Indexes every figure of the array by its centre, ids are array indices.
+template <typename F>
+SpatialGrid<typename std::remove_pointer_t<F>::value_type>
+make_spatial_grid(const MyArray<F>& figures, typename std::remove_pointer_t<F>::value_type cell_size,
+        size_t threads_number = 1) {
+    SpatialGrid<typename std::remove_pointer_t<F>::value_type> grid(cell_size);
+    auto centres = figures.calc_centres(threads_number);
+    for (size_t i{0}; i < centres.size(); ++i) {
+        grid.insert(i, centres[i]);
+    }
+    return grid;
+}
+
+#endif
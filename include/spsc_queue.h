@@ -0,0 +1,70 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <bit>
+#include <exception>
+#include <memory>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// The capacity is rounded up to a power of two. try_push fails when the queue is full,
+// which is how a fast producer feels backpressure.
+template <typename T>
+class SpscQueue final
+{
+private:
+    std::unique_ptr<T[]> _slots;
+    size_t _mask;
+    // Written by the consumer only.
+    alignas(64) std::atomic<size_t> _head{0};
+    // Written by the producer only.
+    alignas(64) std::atomic<size_t> _tail{0};
+
+public:
+    explicit SpscQueue(size_t capacity) :
+        _slots(new T[std::bit_ceil(capacity)]),
+        _mask(std::bit_ceil(capacity) - 1)
+    {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+    }
+
+    SpscQueue(const SpscQueue<T>&) = delete;
+
+    SpscQueue<T>& operator=(const SpscQueue<T>&) = delete;
+
+    ~SpscQueue() noexcept = default;
+
+public:
+    size_t capacity() const {
+        return _mask + 1;
+    }
+
+    // Approximate when called while the other side is running.
+    size_t size() const {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+    bool try_push(const T& value) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == capacity()) {
+            return false;
+        }
+        _slots[tail & _mask] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = _slots[head & _mask];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif
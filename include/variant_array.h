@@ -0,0 +1,156 @@
+#ifndef VARIANT_ARRAY_H
+#define VARIANT_ARRAY_H
+
+#include "./inline_regular_polygon.h"
+#include "./parallel.h"
+#include <exception>
+#include <initializer_list>
+#include <iostream>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Mixed collection of regular polygons with the vertex counts Vs..., stored by value
+// in one contiguous vector. Operations go through std::visit over the concrete
+// polygon types, so there are no virtual calls and no dynamic_cast.
+template <Scalar T, int... Vs>
+class VariantArray
+{
+public:
+    using value_type = T;
+    using figure_type = std::variant<InlineRegularPolygon<T, Vs>...>;
+
+private:
+    std::vector<figure_type> _body;
+
+public:
+    VariantArray() = default;
+
+    VariantArray(const std::initializer_list<figure_type>& figures) :
+        _body(figures)
+    {}
+
+    VariantArray(const VariantArray<T, Vs...>& other) = default;
+
+    VariantArray(VariantArray<T, Vs...>&& other) noexcept = default;
+
+    VariantArray<T, Vs...>& operator=(const VariantArray<T, Vs...>& other) = default;
+
+    VariantArray<T, Vs...>& operator=(VariantArray<T, Vs...>&& other) noexcept = default;
+
+    ~VariantArray() noexcept = default;
+
+public:
+    size_t size() const {
+        return _body.size();
+    }
+
+    void reserve(size_t n) {
+        _body.reserve(n);
+    }
+
+    void push_back(const figure_type& figure) {
+        _body.push_back(figure);
+    }
+
+    template <typename F, typename... Args>
+    F& emplace_back(Args&&... args) {
+        return std::get<F>(_body.emplace_back(std::in_place_type<F>, std::forward<Args>(args)...));
+    }
+
+    const figure_type& operator[](size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        return _body[index];
+    }
+
+    int get_vertices_number(size_t index) const {
+        return std::visit([](const auto& figure) { return figure.get_vertices_number(); }, (*this)[index]);
+    }
+
+public:
+    // Reads the points of the polygon kind already stored at index.
+    std::istream& read(size_t index, std::istream& is) {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        std::visit([&is](auto& figure) { is >> figure; }, _body[index]);
+        return is;
+    }
+
+    std::ostream& print(std::ostream& os) const {
+        for (size_t i{0}; i < size(); ++i) {
+            os << i << ": ";
+            std::visit([&os](const auto& figure) { os << figure; }, _body[i]);
+            os << std::endl;
+        }
+        return os;
+    }
+
+    std::ostream& print_centres(std::ostream& os) const {
+        for (size_t i{0}; i < size(); ++i) {
+            os << i << ": " << calc_centre(i) << std::endl;
+        }
+        return os;
+    }
+
+    std::ostream& print_squares(std::ostream& os) const {
+        for (size_t i{0}; i < size(); ++i) {
+            os << i << ": " << square(i) << std::endl;
+        }
+        return os;
+    }
+
+    Point<T> calc_centre(size_t index) const {
+        return std::visit([](const auto& figure) { return figure.calc_centre(); }, _body[index]);
+    }
+
+    T square(size_t index) const {
+        return std::visit([](const auto& figure) { return figure.square(); }, _body[index]);
+    }
+
+    T total_square() const {
+        return total_square(1);
+    }
+
+    // Same chunked reduction as MyArray::total_square, independent of threads_number.
+    T total_square(size_t threads_number) const {
+        std::vector<T> chunk_squares(parallel_chunks_number(size()));
+        parallel_for_chunks(size(), threads_number, [&](size_t chunk, size_t begin, size_t end) {
+            T chunk_square{0};
+            for (size_t i{begin}; i < end; ++i) {
+                chunk_square += square(i);
+            }
+            chunk_squares[chunk] = chunk_square;
+        });
+        T total_square{0};
+        for (const auto &chunk_square : chunk_squares) {
+            total_square += chunk_square;
+        }
+        return total_square;
+    }
+
+    void remove(size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        _body.erase(_body.begin() + index);
+    }
+
+    void swap_remove(size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range");
+        }
+        if (index != size() - 1) {
+            _body[index] = std::move(_body.back());
+        }
+        _body.pop_back();
+    }
+};
+
+// Triangles, hexagons and octagons, the mix MyArray<Figure<T>*> is used for.
+template <Scalar T>
+using PolygonVariantArray = VariantArray<T, 3, 6, 8>;
+
+#endif
@@ -2,6 +2,11 @@
 #define TEST_H
 
 #include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "../include/point.h"
 
 template <Scalar T>
@@ -18,4 +23,20 @@ inline Point<T> mean(std::vector<Point<T>>& points) {
     return mean / points.size();
 }
 
+// One record in the whitespace-separated format parse_figures reads, with enough
+// digits for the points to validate again.
+inline std::string figure_line(const std::vector<Point<double>>& points) {
+    std::stringstream ss;
+    ss << std::setprecision(17);
+    for (const auto &p : points) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    ss << "\n";
+    return ss.str();
+}
+
+inline std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "../include/compact_regular_polygon.h"
+#include "../include/my_array.h"
+#include "./test.h"
+#include <sstream>
+#include <limits>
+#include <iomanip>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<CompactRegularPolygon<double, 8>>);
+static_assert(sizeof(CompactRegularPolygon<double, 8>) == 4 * sizeof(double));
+static_assert(sizeof(CompactRegularPolygon<float, 6>) == 4 * sizeof(float));
+
+template <int V>
+static void check_matches_regular_polygon() {
+    const double pi = std::numbers::pi;
+    for (const double angle : { -pi, -1.0, 0.0, pi / 7, 2.5 }) {
+        std::vector<Point<double>> points = gen_regular_polygon_points<double>(V, 1.5, -2, angle, 4.2);
+        RegularPolygon<double, V> heap(points);
+        CompactRegularPolygon<double, V> compact(points);
+        EXPECT_EQ(compact.get_vertices_number(), V);
+        for (int i{0}; i < V; ++i) {
+            EXPECT_TRUE(compact[i] == heap[i]);
+        }
+        EXPECT_ANY_THROW(compact[V]);
+        EXPECT_ANY_THROW(compact[-1]);
+        EXPECT_TRUE(compact.calc_centre() == heap.calc_centre());
+        EXPECT_TRUE(scalar_eq(compact.side_length(), 4.2));
+        EXPECT_TRUE(scalar_eq(static_cast<double>(compact), static_cast<double>(heap)));
+        EXPECT_TRUE(compact.get_bounding_box() == heap.get_bounding_box());
+        std::array<Point<double>, V> generated = compact.get_points();
+        EXPECT_FALSE(regular_polygon_invalid(generated.data(), generated.size()));
+        EXPECT_TRUE((compact == CompactRegularPolygon<double, V>(heap)));
+        EXPECT_TRUE((compact == CompactRegularPolygon<double, V>(InlineRegularPolygon<double, V>(points))));
+    }
+}
+
+TEST(CompactRegularPolygonTest, MatchesRegularPolygon) {
+    check_matches_regular_polygon<3>();
+    check_matches_regular_polygon<6>();
+    check_matches_regular_polygon<8>();
+}
+
+TEST(CompactRegularPolygonTest, Parameters) {
+    const double pi = std::numbers::pi;
+    CompactRegularPolygon<double, 6> hex(Point<double>(1, 1), 2, pi / 2);
+    EXPECT_TRUE(hex[0] == Point<double>(1, 3));
+    EXPECT_TRUE(hex.get_centre() == Point<double>(1, 1));
+    EXPECT_TRUE(scalar_eq(hex.get_circumradius(), 2.0));
+    EXPECT_TRUE(scalar_eq(hex.get_phase(), pi / 2));
+    EXPECT_TRUE(scalar_eq(hex.side_length(), 2.0));
+    EXPECT_TRUE(scalar_eq(hex.square(), regular_polygon_square<double>(6, 2)));
+    // Clockwise: the second vertex is to the right of the first one.
+    EXPECT_GT(hex[1].get_x(), hex[0].get_x());
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(Point<double>(0, 0), 0, 0)));
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(Point<double>(nan, 0), 1, 0)));
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(Point<double>(0, inf), 1, 0)));
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(Point<double>(0, 0), inf, 0)));
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(Point<double>(0, 0), 1, nan)));
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(Point<double>(0, 0), 1, inf)));
+
+    hex.translate(Point<double>(-1, -1));
+    hex.rotate(-pi / 2);
+    hex.scale(3);
+    EXPECT_TRUE(hex[0] == Point<double>(6, 0));
+    EXPECT_TRUE(hex.calc_centre() == Point<double>(0, 0));
+    EXPECT_ANY_THROW(hex.translate(Point<double>(std::numeric_limits<double>::infinity(), 0)));
+    EXPECT_ANY_THROW(hex.rotate(std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_ANY_THROW(hex.scale(std::numeric_limits<double>::infinity()));
+    EXPECT_TRUE(hex[0] == Point<double>(6, 0));
+
+    CompactRegularPolygon<double, 6> tiny(Point<double>(0, 0), 1, 0);
+    EXPECT_NO_THROW(tiny.scale(2 * Point<double>::eps));
+    EXPECT_NEAR(tiny.get_circumradius(), 2 * Point<double>::eps, 1e-15);
+    EXPECT_ANY_THROW(tiny.scale(Point<double>::eps / 2));
+}
+
+TEST(CompactRegularPolygonTest, Validation) {
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(gen_regular_polygon_points<double>(8, 0, 0, 0, 1))));
+    std::vector<Point<double>> bad = gen_regular_polygon_points<double>(6, 0, 0, 0, 1);
+    bad[2] = bad[2] + Point<double>(0.1, 0);
+    EXPECT_ANY_THROW((CompactRegularPolygon<double, 6>(bad)));
+    EXPECT_FALSE((CompactRegularPolygon<double, 6>::make(std::span<const Point<double>, 6>(bad.data(), 6))));
+    CompactRegularPolygon<double, 3> tr;
+    std::stringstream ss("0 0 0 1 1 1");
+    EXPECT_ANY_THROW(ss >> tr);
+    EXPECT_TRUE((tr == CompactRegularPolygon<double, 3>()));
+}
+
+TEST(CompactRegularPolygonTest, MyArray) {
+    constexpr int v{8};
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(v, 4, 4, 0.2, 3.3);
+    MyArray<CompactRegularPolygon<double, v>> arr(3);
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (const auto &p : points) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    EXPECT_NO_THROW(arr.read(1, ss));
+    RegularPolygon<double, v> expected(points);
+    EXPECT_TRUE(scalar_eq(arr.total_square(), 2 * static_cast<double>(RegularPolygon<double, v>()) + static_cast<double>(expected)));
+    EXPECT_TRUE(arr[1].calc_centre() == expected.calc_centre());
+    std::stringstream out;
+    arr.print(out);
+    EXPECT_NE(out.str().find("1: Octagon: [ "), std::string::npos);
+    EXPECT_EQ(arr.filter_by_point(expected.calc_centre()), std::vector<size_t>{ 1 });
+    EXPECT_EQ(arr.group_by_equality().size(), 2u);
+    arr.translate(Point<double>(1, 0));
+    EXPECT_TRUE(arr[1].calc_centre() == expected.calc_centre() + Point<double>(1, 0));
+
+    CompactRegularPolygon<double, v> single = arr[1];
+    single.rotate(0.7, Point<double>(2, -3));
+    arr.rotate(0.7, Point<double>(2, -3), 2);
+    for (int j{0}; j < v; ++j) {
+        EXPECT_TRUE(arr[1][j] == single[j]);
+    }
+}
+
+TEST(CompactRegularPolygonTest, Contains) {
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(6, 1, 1, 0.4, 2);
+    CompactRegularPolygon<double, 6> compact(points);
+    InlineRegularPolygon<double, 6> inl(points);
+    for (double x{-4}; x <= 6; x += 0.25) {
+        for (double y{-4}; y <= 6; y += 0.25) {
+            EXPECT_EQ(compact.contains(Point<double>(x, y)), inl.contains(Point<double>(x, y)));
+        }
+    }
+    EXPECT_TRUE(compact.contains(compact.calc_centre()));
+    EXPECT_TRUE(compact.contains(points[3]));
+}
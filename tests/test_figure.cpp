@@ -2,10 +2,13 @@
 #include "../include/figure.h"
 #include "../include/regular_polygon.h"
 #include "../include/my_array.h"
+#include "../include/inline_regular_polygon.h"
 #include "./test.h"
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <limits>
+#include <thread>
 
 const double pi = std::numbers::pi;
 
@@ -75,6 +78,7 @@ TEST(FigureTest, ConstructorMove) {
         RegularPolygon<double, v> original(points);
         RegularPolygon<double, v> move_to(std::move(original));
         EXPECT_NE(&original, &move_to);
+        EXPECT_FALSE(original.contains(move_to.calc_centre()));
         for (int i{0}; i < v; ++i) {
             EXPECT_ANY_THROW(original[i] == points[i]);
             EXPECT_TRUE(move_to[i] == points[i]);
@@ -151,6 +155,7 @@ TEST(FigureTest, AssignMoveOperator) {
         RegularPolygon<double, v> move_to;
         move_to = std::move(original);
         EXPECT_NE(&original, &move_to);
+        EXPECT_FALSE(original.contains(move_to.calc_centre()));
         for (int i{0}; i < v; ++i) {
             EXPECT_TRUE(move_to[i] == points[i]);
             EXPECT_ANY_THROW(original[i] == points[i]);
@@ -331,4 +336,749 @@ TEST(FigureTest, CalcCentre) {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(MyArrayTest, ParallelAggregation) {
+    constexpr int v{6};
+    constexpr size_t n{20000};
+    MyArray<RegularPolygon<double, v>> arr(n);
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (size_t i{0}; i < n; i += 997) {
+        std::vector<Point<double>> points = gen_regular_polygon_points<double>(v, i * 0.01, -1.0 * i, i * 0.001, 1 + i * 0.1);
+        for (const auto &p : points) {
+            ss << p.get_x() << " " << p.get_y() << " ";
+        }
+    }
+    for (size_t i{0}; i < n; i += 997) {
+        arr.read(i, ss);
+    }
+
+    const double serial = arr.total_square();
+    for (size_t threads : { 0, 1, 2, 3, 8, 32 }) {
+        EXPECT_EQ(arr.total_square(threads), serial);
+    }
+
+    std::vector<double> squares = arr.calc_squares(4);
+    std::vector<Point<double>> centres = arr.calc_centres(4);
+    ASSERT_EQ(squares.size(), n);
+    ASSERT_EQ(centres.size(), n);
+    RegularPolygon<double, v> sample(gen_regular_polygon_points<double>(v, 997 * 0.01, -997.0, 0.997, 1 + 99.7));
+    EXPECT_TRUE(scalar_eq(squares[997], static_cast<double>(sample)));
+    EXPECT_TRUE(centres[997] == sample.calc_centre());
+    EXPECT_TRUE(scalar_eq(squares[1], static_cast<double>(RegularPolygon<double, v>())));
+
+    std::stringstream serial_out;
+    std::stringstream parallel_out;
+    arr.print_squares(serial_out);
+    arr.print_squares(parallel_out, 4);
+    EXPECT_EQ(serial_out.str(), parallel_out.str());
+    serial_out.str("");
+    parallel_out.str("");
+    arr.print_centres(serial_out);
+    arr.print_centres(parallel_out, 4);
+    EXPECT_EQ(serial_out.str(), parallel_out.str());
+}
+
+TEST(MyArrayTest, MemoryResource) {
+    constexpr int v{6};
+    std::pmr::monotonic_buffer_resource arena;
+    {
+        RegularPolygon<double, v> h1(gen_regular_polygon_points<double>(v, 4, 4, 0, 3.3), &arena);
+        EXPECT_EQ(h1.get_allocator().resource(), &arena);
+        RegularPolygon<double, v> copy(h1);
+        EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+        RegularPolygon<double, v> arena_copy(h1, &arena);
+        EXPECT_EQ(arena_copy.get_allocator().resource(), &arena);
+        EXPECT_TRUE(arena_copy == h1);
+        copy = h1;
+        EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+        RegularPolygon<double, v> moved(std::move(arena_copy));
+        EXPECT_EQ(moved.get_allocator().resource(), &arena);
+        RegularPolygon<double, v> stolen(std::move(moved), &arena);
+        EXPECT_EQ(moved.get_vertices_number(), 0);
+        EXPECT_FALSE(moved.contains(stolen.calc_centre()));
+    }
+    {
+        // Move-assignment keeps the destination's resource, so the figure outlives the arena.
+        MyArray<RegularPolygon<double, v>> heap(1);
+        {
+            std::pmr::monotonic_buffer_resource scoped;
+            RegularPolygon<double, v> from_arena(gen_regular_polygon_points<double>(v, 1, 2, 0, 5), &scoped);
+            heap[0] = std::move(from_arena);
+            EXPECT_EQ(heap[0].get_allocator().resource(), std::pmr::get_default_resource());
+            EXPECT_EQ(from_arena.get_allocator().resource(), &scoped);
+
+            Figure<double> &base = heap[0];
+            RegularPolygon<double, v> other(gen_regular_polygon_points<double>(v, 0, 0, 0, 3), &scoped);
+            base = std::move(static_cast<Figure<double>&>(other));
+            EXPECT_EQ(heap[0].get_allocator().resource(), std::pmr::get_default_resource());
+            heap[0] = std::move(from_arena);
+        }
+        std::stringstream ss;
+        ss << heap[0];
+        EXPECT_TRUE(scalar_eq(heap[0].side_length(), 5.0));
+        std::vector<Point<double>> expected = gen_regular_polygon_points<double>(v, 1, 2, 0, 5);
+        EXPECT_TRUE(heap[0].calc_centre() == mean(expected));
+
+        RegularPolygon<double, v> source(gen_regular_polygon_points<double>(v, 0, 0, 0, 2));
+        heap[0] = std::move(source);
+        EXPECT_EQ(source.get_vertices_number(), 0);
+        EXPECT_TRUE(scalar_eq(heap[0].side_length(), 2.0));
+    }
+    {
+        std::pmr::unsynchronized_pool_resource pool;
+        MyArray<RegularPolygon<double, v>> arr(5, &pool);
+        EXPECT_EQ(arr.get_allocator().resource(), &pool);
+        EXPECT_TRUE(scalar_eq(arr.total_square(), 5 * static_cast<double>(RegularPolygon<double, v>())));
+
+        MyArray<RegularPolygon<double, v>> copy(arr, &arena);
+        EXPECT_EQ(copy.get_allocator().resource(), &arena);
+        EXPECT_TRUE(scalar_eq(copy.total_square(), arr.total_square()));
+        copy = arr;
+        EXPECT_EQ(copy.get_allocator().resource(), &arena);
+        copy.remove(0);
+        EXPECT_EQ(copy.size(), 4u);
+
+        copy = std::move(arr);
+        EXPECT_EQ(copy.get_allocator().resource(), &arena);
+        EXPECT_EQ(copy.size(), 5u);
+        EXPECT_EQ(copy[0].get_allocator().resource(), &arena);
+        MyArray<RegularPolygon<double, v>> same(0, &arena);
+        same = std::move(copy);
+        EXPECT_EQ(same.size(), 5u);
+        EXPECT_EQ(copy.size(), 0u);
+    }
+    {
+        MyArray<Figure<double>*> pointers(3, &arena);
+        EXPECT_EQ(pointers.size(), 3u);
+    }
+}
+
+TEST(FigureTest, MetricsCaching) {
+    constexpr int v{8};
+    std::vector<Point<double>> points1 = gen_regular_polygon_points<double>(v, 4, 4, pi/5, 3.3);
+    std::vector<Point<double>> points2 = gen_regular_polygon_points<double>(v, -1, 2, pi/3, 7);
+    RegularPolygon<double, v> expected1(points1);
+    RegularPolygon<double, v> expected2(points2);
+
+    RegularPolygon<double, v> oc(points1);
+    EXPECT_FALSE(oc.get_metrics_caching());
+    oc.set_metrics_caching(true);
+    EXPECT_TRUE(oc.get_metrics_caching());
+    EXPECT_TRUE(scalar_eq(static_cast<double>(oc), static_cast<double>(expected1)));
+    EXPECT_TRUE(oc.calc_centre() == expected1.calc_centre());
+    EXPECT_TRUE(scalar_eq(oc.side_length(), 3.3));
+    EXPECT_TRUE(scalar_eq(static_cast<double>(oc), static_cast<double>(expected1)));
+
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (const auto &p : points2) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    ss >> oc;
+    EXPECT_TRUE(scalar_eq(static_cast<double>(oc), static_cast<double>(expected2)));
+    EXPECT_TRUE(oc.calc_centre() == expected2.calc_centre());
+    EXPECT_TRUE(scalar_eq(oc.side_length(), 7.0));
+
+    RegularPolygon<double, v> copy(oc);
+    EXPECT_TRUE(copy.get_metrics_caching());
+    EXPECT_TRUE(copy.calc_centre() == expected2.calc_centre());
+    copy = expected1;
+    EXPECT_FALSE(copy.get_metrics_caching());
+    EXPECT_TRUE(copy.calc_centre() == expected1.calc_centre());
+    oc = std::move(copy);
+    EXPECT_FALSE(oc.get_metrics_caching());
+    EXPECT_TRUE(scalar_eq(static_cast<double>(oc), static_cast<double>(expected1)));
+
+    MyArray<RegularPolygon<double, v>> arr{ expected1, expected2 };
+    const double total = arr.total_square();
+    arr.set_metrics_caching(true);
+    EXPECT_TRUE(scalar_eq(arr.total_square(), total));
+    EXPECT_TRUE(scalar_eq(arr.total_square(), total));
+    MyArray<Figure<double>*> pointers{ &expected1, &expected2 };
+    pointers.set_metrics_caching(true);
+    EXPECT_TRUE(expected1.get_metrics_caching());
+    EXPECT_TRUE(scalar_eq(pointers.total_square(), total));
+}
+
+TEST(FigureTest, FastValidation) {
+    for (const auto &x : x_points) {
+        for (const auto &angle : angles) {
+            for (const auto &side : sides) {
+                for (int v : { 3, 4, 5, 6, 8, 12 }) {
+                    std::vector<Point<double>> points = gen_regular_polygon_points(v, x, -x, angle, side);
+                    EXPECT_FALSE(regular_polygon_invalid(points.data(), points.size()));
+                    std::vector<Point<double>> reversed(points.rbegin(), points.rend());
+                    EXPECT_TRUE(regular_polygon_invalid(reversed.data(), reversed.size()));
+                }
+            }
+        }
+    }
+    std::vector<Point<double>> rectangle{ {0, 0}, {0, 1}, {2, 1}, {2, 0} };
+    EXPECT_FALSE(convex_polygon_invalid(rectangle.data(), rectangle.size()));
+    EXPECT_TRUE(regular_polygon_invalid(rectangle.data(), rectangle.size()));
+    EXPECT_TRUE(convex_polygon_invalid<double>(nullptr, 0));
+    EXPECT_TRUE(convex_polygon_invalid(rectangle.data(), 2));
+    std::vector<Point<double>> pentagon = gen_regular_polygon_points<double>(5, 0, 0, 0, 1);
+    std::vector<Point<double>> pentagram{ pentagon[0], pentagon[2], pentagon[4], pentagon[1], pentagon[3] };
+    EXPECT_TRUE(regular_polygon_invalid(pentagram.data(), pentagram.size()));
+    EXPECT_FALSE((regular_polygon_invalid<double, 5>(pentagon.data())));
+    EXPECT_TRUE((regular_polygon_invalid<double, 5>(pentagram.data())));
+    std::vector<Point<double>> degenerate(6, Point<double>(1, 1));
+    EXPECT_TRUE(regular_polygon_invalid(degenerate.data(), degenerate.size()));
+
+    std::vector<Point<double>> batch = gen_regular_polygon_points<double>(6, 0, 0, 0, 2);
+    std::vector<Point<double>> bad{ {0, 0}, {0, 1}, {1, 1}, {2, 0.5}, {2, 0}, {1, -1} };
+    batch.insert(batch.end(), bad.begin(), bad.end());
+    std::vector<Point<double>> good = gen_regular_polygon_points<double>(6, 5, 5, pi/3, 0.5);
+    batch.insert(batch.end(), good.begin(), good.end());
+    bool valid[3];
+    EXPECT_EQ((validate_regular_polygons<double, 6>(batch, valid)), 2u);
+    EXPECT_TRUE(valid[0]);
+    EXPECT_FALSE(valid[1]);
+    EXPECT_TRUE(valid[2]);
+    EXPECT_ANY_THROW((validate_regular_polygons<double, 6>(std::span<const Point<double>>(batch).first(10), valid)));
+}
+
+TEST(FigureTest, ValidationRuleIsShared) {
+    std::vector<Point<double>> almost{ {0, 0}, {0, 1}, {1, 1.01}, {1, 0} };
+    EXPECT_FALSE(convex_polygon_invalid(almost.data(), almost.size()));
+    EXPECT_ANY_THROW((RegularPolygon<double, 4>(almost)));
+    RegularPolygon<double, 4> square;
+    std::stringstream ss;
+    for (const auto &p : almost) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    EXPECT_ANY_THROW(ss >> square);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(6, 0, 0, 0, 1);
+    for (double bad : { nan, inf, -inf }) {
+        std::vector<Point<double>> broken = points;
+        broken[2] = Point<double>(bad, 0);
+        EXPECT_TRUE(convex_polygon_invalid(broken.data(), broken.size()));
+        EXPECT_TRUE(regular_polygon_invalid(broken.data(), broken.size()));
+        EXPECT_ANY_THROW((RegularPolygon<double, 6>(broken)));
+        EXPECT_FALSE((InlineRegularPolygon<double, 6>::make(std::span<const Point<double>, 6>(broken.data(), 6))));
+    }
+    std::vector<Point<double>> all_nan(6, Point<double>(nan, nan));
+    EXPECT_TRUE(regular_polygon_invalid(all_nan.data(), all_nan.size()));
+}
+
+TEST(MyArrayTest, Growable) {
+    constexpr int v{3};
+    std::pmr::unsynchronized_pool_resource pool;
+    MyArray<RegularPolygon<double, v>> arr(0, &pool);
+    EXPECT_EQ(arr.size(), 0u);
+    arr.reserve(10);
+    EXPECT_EQ(arr.capacity(), 10u);
+    for (int i{0}; i < 100; ++i) {
+        arr.push_back(RegularPolygon<double, v>(gen_regular_polygon_points<double>(v, i, 0, 0, 1 + i)));
+    }
+    EXPECT_EQ(arr.size(), 100u);
+    EXPECT_GE(arr.capacity(), 100u);
+    for (size_t i{0}; i < arr.size(); ++i) {
+        EXPECT_TRUE(scalar_eq(arr[i].side_length(), 1.0 + i));
+        EXPECT_EQ(arr[i].get_allocator().resource(), &pool);
+    }
+    EXPECT_ANY_THROW(arr[100]);
+
+    RegularPolygon<double, v> &added = arr.emplace_back(gen_regular_polygon_points<double>(v, 0, 0, 0, 500));
+    EXPECT_EQ(added.get_allocator().resource(), &pool);
+    EXPECT_TRUE(scalar_eq(arr[100].side_length(), 500.0));
+
+    RegularPolygon<double, v> same_resource(gen_regular_polygon_points<double>(v, 0, 0, 0, 2), &pool);
+    arr.push_back(std::move(same_resource));
+    EXPECT_EQ(same_resource.get_vertices_number(), 0);
+    EXPECT_TRUE(scalar_eq(arr[101].side_length(), 2.0));
+
+    arr.swap_remove(0);
+    EXPECT_EQ(arr.size(), 101u);
+    EXPECT_TRUE(scalar_eq(arr[0].side_length(), 2.0));
+    arr.remove(1);
+    EXPECT_EQ(arr.size(), 100u);
+    EXPECT_TRUE(scalar_eq(arr[1].side_length(), 3.0));
+    EXPECT_ANY_THROW(arr.remove(100));
+    EXPECT_ANY_THROW(arr.swap_remove(100));
+
+    size_t removed = arr.erase_if([](const RegularPolygon<double, v>& figure) {
+        return figure.side_length() > 50;
+    });
+    EXPECT_EQ(removed, 51u);
+    EXPECT_EQ(arr.size(), 49u);
+    for (size_t i{1}; i < arr.size(); ++i) {
+        EXPECT_TRUE(scalar_eq(arr[i].side_length(), 2.0 + i));
+    }
+    arr.shrink_to_fit();
+    EXPECT_EQ(arr.capacity(), 49u);
+    EXPECT_TRUE(scalar_eq(arr[48].side_length(), 50.0));
+
+    RegularPolygon<double, 6> h;
+    RegularPolygon<double, 8> o;
+    MyArray<Figure<double>*> pointers(0);
+    pointers.push_back(&h);
+    pointers.push_back(&o);
+    EXPECT_EQ(pointers.erase_if([](Figure<double>* figure) { return figure->get_vertices_number() == 6; }), 1u);
+    EXPECT_EQ(pointers[0], &o);
+}
+
+TEST(MyArrayTest, SelfReferencingPushBack) {
+    constexpr int v{3};
+    MyArray<RegularPolygon<double, v>> arr(0);
+    arr.push_back(RegularPolygon<double, v>(gen_regular_polygon_points<double>(v, 0, 0, 0, 1)));
+    for (int i{0}; i < 20; ++i) {
+        arr.push_back(arr[0]);
+        arr.emplace_back(arr[arr.size() - 1]);
+    }
+    arr.shrink_to_fit();
+    ASSERT_EQ(arr.size(), arr.capacity());
+    arr.push_back(arr[arr.size() - 1]);
+    EXPECT_EQ(arr.size(), 42u);
+    for (size_t i{0}; i < arr.size(); ++i) {
+        EXPECT_TRUE(scalar_eq(arr[i].side_length(), 1.0));
+    }
+
+    MyArray<RegularPolygon<double, v>> shared(arr);
+    shared.push_back(shared[0]);
+    EXPECT_EQ(shared.size(), 43u);
+    EXPECT_EQ(arr.size(), 42u);
+}
+
+TEST(FigureTest, BoundingBox) {
+    for (const auto &angle : angles) {
+        for (const auto &side : sides) {
+            std::vector<Point<double>> points = gen_regular_polygon_points<double>(8, 3, -2, angle, side);
+            RegularPolygon<double, 8> oc(points);
+            BoundingBox<double> box = oc.get_bounding_box();
+            for (const auto &p : points) {
+                EXPECT_TRUE(box.contains(p));
+            }
+            EXPECT_TRUE(box.contains(oc.calc_centre()));
+            EXPECT_TRUE(box == BoundingBox<double>::from_points(points.data(), points.size()));
+            EXPECT_TRUE((box == InlineRegularPolygon<double, 8>(points).get_bounding_box()));
+            RegularPolygon<double, 8> copy(oc);
+            EXPECT_TRUE(copy.get_bounding_box() == box);
+        }
+    }
+    RegularPolygon<double, 3> tr;
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (const auto &p : gen_regular_polygon_points<double>(3, 100, 100, 0, 2)) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    ss >> tr;
+    EXPECT_TRUE(tr.get_bounding_box().contains(Point<double>(100, 100)));
+    EXPECT_FALSE(tr.get_bounding_box().contains(Point<double>(0, 0)));
+    EXPECT_ANY_THROW(BoundingBox<double>(Point<double>(1, 1), Point<double>(0, 0)));
+}
+
+TEST(MyArrayTest, BoundingBoxFilters) {
+    MyArray<RegularPolygon<double, 6>> arr(0);
+    for (int i{0}; i < 10; ++i) {
+        arr.emplace_back(gen_regular_polygon_points<double>(6, 10.0 * i, 0, 0, 1));
+    }
+    BoundingBox<double> window(Point<double>(15, -5), Point<double>(35, 5));
+    EXPECT_EQ(arr.filter_by_box(window), (std::vector<size_t>{ 2, 3 }));
+    std::vector<size_t> exact = arr.filter_by_box(window, [](const RegularPolygon<double, 6>& figure) {
+        return figure.calc_centre().get_x() > 25;
+    });
+    EXPECT_EQ(exact, std::vector<size_t>{ 3 });
+    EXPECT_EQ(arr.filter_by_point(arr[4].calc_centre()), std::vector<size_t>{ 4 });
+    EXPECT_TRUE(arr.filter_by_point(Point<double>(5, 50)).empty());
+}
+
+TEST(MyArrayTest, EqualityIndex) {
+    MyArray<RegularPolygon<double, 6>> arr(0);
+    const double sides_seq[] = { 1, 2, 1, 3, 2, 1 + 1e-7, 5 };
+    for (size_t i{0}; i < std::size(sides_seq); ++i) {
+        arr.emplace_back(gen_regular_polygon_points<double>(6, i, -1.0 * i, 0.1 * i, sides_seq[i]));
+    }
+    EXPECT_EQ(arr.find_equal(arr[0]), (std::vector<size_t>{ 0, 2, 5 }));
+    EXPECT_EQ(arr.find_equal(arr[6]), std::vector<size_t>{ 6 });
+    std::vector<std::vector<size_t>> groups = arr.group_by_equality();
+    EXPECT_EQ(groups, (std::vector<std::vector<size_t>>{ { 0, 2, 5 }, { 1, 4 }, { 3 }, { 6 } }));
+    EXPECT_EQ(arr.dedup(), 3u);
+    ASSERT_EQ(arr.size(), 4u);
+    EXPECT_TRUE(scalar_eq(arr[1].side_length(), 2.0));
+    EXPECT_TRUE(scalar_eq(arr[3].side_length(), 5.0));
+    EXPECT_EQ(arr.dedup(), 0u);
+
+    // Sides straddling a bucket boundary still compare equal.
+    const double eps = Point<double>::eps;
+    RegularPolygon<double, 3> a(gen_regular_polygon_points<double>(3, 0, 0, 0, 2 - eps / 4));
+    RegularPolygon<double, 3> b(gen_regular_polygon_points<double>(3, 5, 5, 1, 2 + eps / 4));
+    RegularPolygon<double, 8> c(gen_regular_polygon_points<double>(8, 0, 0, 0, 2));
+    MyArray<Figure<double>*> figures{ &a, &c, &b };
+    EXPECT_EQ(figures.group_by_equality(), (std::vector<std::vector<size_t>>{ { 0, 2 }, { 1 } }));
+    EXPECT_EQ(figures.find_equal(b), (std::vector<size_t>{ 0, 2 }));
+    EXPECT_EQ(figures.dedup(), 1u);
+    EXPECT_EQ(figures.size(), 2u);
+
+    // Huge and non-finite sides land in the end buckets instead of overflowing.
+    const FigureHashKey huge = make_figure_hash_key(6, 1e300);
+    EXPECT_TRUE(huge == make_figure_hash_key(6, std::numeric_limits<double>::infinity()));
+    EXPECT_TRUE(huge == make_figure_hash_key(6, std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ(huge.neighbour(1).side_bucket, huge.side_bucket + 1);
+    EXPECT_TRUE(make_figure_hash_key(6, -1e300) == make_figure_hash_key(6, -1e200));
+    EXPECT_EQ(make_figure_hash_key(6, 2.5).side_bucket, 2500000);
+}
+
+TEST(FigureTest, UnitPolygonTables) {
+    static_assert(regular_polygon_unit_points<double, 6>[0][0] == 0);
+    static_assert(regular_polygon_unit_points<double, 4>[1][1] == 1);
+    for (const auto &angle : angles) {
+        for (const auto &side : sides) {
+            std::vector<Point<double>> expected = gen_regular_polygon_points<double>(8, 3, -2, angle, side);
+            std::array<Point<double>, 8> points = gen_regular_polygon_points<double, 8>(3, -2, angle, side);
+            for (size_t i{0}; i < points.size(); ++i) {
+                EXPECT_TRUE(points[i] == expected[i]);
+            }
+            RegularPolygon<double, 8> oc(std::vector<Point<double>>(points.begin(), points.end()));
+            EXPECT_TRUE(scalar_eq(oc.side_length(), side));
+        }
+    }
+    std::array<Point<float>, 3> tr = gen_regular_polygon_points<float, 3>(1, 1, 0.5f, 4);
+    EXPECT_FALSE(regular_polygon_invalid(tr.data(), tr.size()));
+    EXPECT_NO_THROW((InlineRegularPolygon<double, 6>(gen_regular_polygon_points<double, 6>(0, 0, 1, 2))));
+}
+
+TEST(FigureTest, FloatPrecision) {
+    const std::vector<float> far_points{ -1000.5f, -250.25f, 0, 3.3f, 999.9f };
+    MyArray<RegularPolygon<float, 6>> hexagons(0);
+    double expected_total{0};
+    for (const auto &x : far_points) {
+        for (const auto &angle : angles) {
+            for (const auto &side : sides) {
+                std::vector<Point<float>> points = gen_regular_polygon_points<float>(6, x, -x, static_cast<float>(angle), static_cast<float>(side) / 10);
+                EXPECT_FALSE(regular_polygon_invalid(points.data(), points.size()));
+                EXPECT_NO_THROW((InlineRegularPolygon<float, 6>(points)));
+                hexagons.emplace_back(points);
+                expected_total += regular_polygon_square<double>(6, side / 10);
+            }
+        }
+    }
+    EXPECT_NEAR(hexagons.total_square(), expected_total, expected_total * 1e-5);
+    EXPECT_NEAR(hexagons.total_square(4), expected_total, expected_total * 1e-5);
+    EXPECT_TRUE((hexagons[0] == RegularPolygon<float, 6>(gen_regular_polygon_points<float>(6, 7, 7, 1, 0.15f))));
+
+    std::vector<Point<float>> triangle = gen_regular_polygon_points<float>(3, 500, 500, 0.3f, 2);
+    RegularPolygon<float, 3> tr(triangle);
+    EXPECT_NEAR(static_cast<float>(tr), regular_polygon_square<float>(3, 2), 1e-3f);
+    EXPECT_TRUE(tr.calc_centre() == mean(triangle));
+    triangle[1] = triangle[1] + Point<float>(0.05f, 0);
+    EXPECT_TRUE(regular_polygon_invalid(triangle.data(), triangle.size()));
+    EXPECT_ANY_THROW((InlineRegularPolygon<float, 3>(triangle)));
+
+    for (float side : { 1e-3f, 5e-3f, 1e-2f }) {
+        for (const auto &angle : angles) {
+            std::vector<Point<float>> small = gen_regular_polygon_points<float>(6, 0.5f, -0.25f, static_cast<float>(angle), side);
+            EXPECT_FALSE(convex_polygon_invalid(small.data(), small.size()));
+            EXPECT_FALSE(regular_polygon_invalid(small.data(), small.size()));
+            EXPECT_NO_THROW((RegularPolygon<float, 6>(small)));
+            EXPECT_NO_THROW((InlineRegularPolygon<float, 6>(small)));
+            std::stringstream ss;
+            ss << std::setprecision(9);
+            for (const auto &p : small) {
+                ss << p.get_x() << " " << p.get_y() << " ";
+            }
+            RegularPolygon<float, 6> read;
+            EXPECT_NO_THROW(ss >> read);
+        }
+    }
+}
+
+TEST(FigureTest, Transforms) {
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(6, 1, 2, 0.3, 2);
+    RegularPolygon<double, 6> hex(points);
+    hex.set_metrics_caching(true);
+    const double square = static_cast<double>(hex);
+    const Point<double> centre = hex.calc_centre();
+
+    hex.translate(Point<double>(10, -5));
+    EXPECT_TRUE(hex.calc_centre() == centre + Point<double>(10, -5));
+    EXPECT_TRUE(hex[0] == points[0] + Point<double>(10, -5));
+    EXPECT_TRUE(hex.get_bounding_box().contains(Point<double>(11, -3)));
+    EXPECT_FALSE(hex.get_bounding_box().contains(points[0]));
+
+    hex.rotate(pi / 3, hex.calc_centre());
+    EXPECT_TRUE(hex.calc_centre() == centre + Point<double>(10, -5));
+    EXPECT_TRUE(scalar_eq(static_cast<double>(hex), square));
+
+    hex.scale(-2, Point<double>(0, 0));
+    EXPECT_TRUE(hex.calc_centre() == (centre + Point<double>(10, -5)) * -2.0);
+    EXPECT_TRUE(scalar_eq(hex.side_length(), 4.0));
+    EXPECT_TRUE(scalar_eq(static_cast<double>(hex), 4 * square));
+    std::vector<Point<double>> moved(6);
+    for (int i{0}; i < 6; ++i) {
+        moved[i] = hex[i];
+    }
+    EXPECT_FALSE(regular_polygon_invalid(moved.data(), moved.size()));
+    EXPECT_ANY_THROW(hex.scale(0));
+
+    // Non-finite arguments are rejected before any vertex is moved.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    EXPECT_ANY_THROW(hex.translate(Point<double>(inf, 0)));
+    EXPECT_ANY_THROW(hex.rotate(nan));
+    EXPECT_ANY_THROW(hex.rotate(1, Point<double>(0, inf)));
+    EXPECT_ANY_THROW(hex.scale(inf));
+    EXPECT_ANY_THROW(hex.scale(nan));
+    EXPECT_TRUE(hex[0] == moved[0]);
+
+    // General affine: a shear is rejected and leaves the figure as it was, a rotation passes.
+    EXPECT_ANY_THROW(hex.transform(1, 0.5, 0, 1, Point<double>(0, 0)));
+    EXPECT_TRUE(hex[0] == moved[0]);
+    hex.transform(std::cos(1.0), -std::sin(1.0), std::sin(1.0), std::cos(1.0), Point<double>(3, 3));
+    EXPECT_TRUE(hex[0] == moved[0].rotate(1.0) + Point<double>(3, 3));
+    EXPECT_TRUE(scalar_eq(hex.side_length(), 4.0));
+}
+
+TEST(FigureTest, SmallScaleFactors) {
+    // Only factors below eps are rejected, the ones just above it scale the figure.
+    const double k = 2 * Point<double>::eps;
+    RegularPolygon<double, 6> hex;
+    EXPECT_NO_THROW(hex.scale(k));
+    EXPECT_NEAR(hex.side_length(), k, 1e-9 * k);
+    EXPECT_NO_THROW(hex.scale(-1 / k));
+    EXPECT_NEAR(hex.side_length(), 1.0, 1e-9);
+    EXPECT_ANY_THROW(hex.scale(Point<double>::eps / 2));
+
+    const float kf = 2 * Point<float>::eps;
+    RegularPolygon<float, 6> hexf;
+    EXPECT_NO_THROW(hexf.scale(kf));
+    EXPECT_NEAR(hexf.side_length(), kf, 1e-4f * kf);
+    EXPECT_ANY_THROW(hexf.scale(Point<float>::eps / 2));
+
+    MyArray<RegularPolygon<double, 6>> arr(3);
+    EXPECT_NO_THROW(arr.scale(k));
+    EXPECT_NEAR(arr[2].side_length(), k, 1e-9 * k);
+}
+
+TEST(MyArrayTest, Transforms) {
+    MyArray<RegularPolygon<double, 8>> arr(0);
+    std::vector<Point<double>> centres;
+    for (int i{0}; i < 100; ++i) {
+        arr.emplace_back(gen_regular_polygon_points<double>(8, i, -i, 0.01 * i, 1 + i % 5));
+        centres.push_back(arr[i].calc_centre());
+    }
+    const double total = arr.total_square();
+    arr.translate(Point<double>(1, 1), 4);
+    arr.rotate(pi / 2, Point<double>(0, 0), 4);
+    arr.scale(3, Point<double>(0, 0));
+    for (size_t i{0}; i < arr.size(); ++i) {
+        Point<double> expected = (centres[i] + Point<double>(1, 1)).rotate(pi / 2) * 3.0;
+        EXPECT_TRUE(arr[i].calc_centre() == expected);
+        EXPECT_TRUE(arr[i].get_bounding_box().contains(expected));
+    }
+    EXPECT_NEAR(arr.total_square(), 9 * total, 1e-6 * total);
+    arr.transform(-1, 0, 0, -1, Point<double>(0, 0));
+    EXPECT_TRUE(arr[5].calc_centre() == (centres[5] + Point<double>(1, 1)).rotate(pi / 2) * -3.0);
+    EXPECT_ANY_THROW(arr.transform(2, 0, 0, 1, Point<double>(0, 0), 2));
+
+    EXPECT_ANY_THROW(arr.rotate(std::numeric_limits<double>::infinity()));
+    RegularPolygon<double, 8> single = arr[7];
+    single.rotate(-1.2, Point<double>(5, 5));
+    arr.rotate(-1.2, Point<double>(5, 5));
+    for (int j{0}; j < 8; ++j) {
+        EXPECT_TRUE(arr[7][j] == single[j]);
+    }
+}
+
+TEST(MyArrayTest, AreaSelection) {
+    MyArray<RegularPolygon<double, 6>> arr(0);
+    const std::vector<double> sides_seq{ 3, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+    for (size_t i{0}; i < sides_seq.size(); ++i) {
+        arr.emplace_back(gen_regular_polygon_points<double>(6, i, 0, 0, sides_seq[i]));
+    }
+    EXPECT_EQ(arr.top_k_by_area(3), (std::vector<size_t>{ 5, 7, 4 }));
+    EXPECT_EQ(arr.top_k_by_area(4), (std::vector<size_t>{ 5, 7, 4, 8 }));
+    EXPECT_EQ(arr.top_k_by_area(0), std::vector<size_t>{});
+    EXPECT_EQ(arr.top_k_by_area(100).size(), arr.size());
+    EXPECT_EQ(arr.nth_by_area(0), 1);
+    EXPECT_EQ(arr.nth_by_area(1), 3);
+    EXPECT_EQ(arr.nth_by_area(9), 5);
+    EXPECT_EQ(arr.nth_by_area(4), 9);
+    EXPECT_EQ(arr.nth_by_area(5), 2);
+    EXPECT_ANY_THROW(arr.nth_by_area(10));
+    EXPECT_EQ(arr.filter_by_area(regular_polygon_square<double>(6, 3), regular_polygon_square<double>(6, 5)),
+            (std::vector<size_t>{ 0, 2, 4, 8, 9 }));
+
+    // Chunked selection across threads matches a full sort.
+    MyArray<InlineRegularPolygon<double, 3>> big(0);
+    std::vector<std::pair<double, size_t>> expected;
+    for (size_t i{0}; i < 20000; ++i) {
+        double side = 1 + static_cast<double>((i * 7919) % 1000);
+        big.emplace_back(gen_regular_polygon_points<double>(3, 0, 0, 0, side));
+        expected.emplace_back(-static_cast<double>(big[i]), i);
+    }
+    std::sort(expected.begin(), expected.end());
+    std::vector<size_t> top = big.top_k_by_area(50, 4);
+    ASSERT_EQ(top.size(), 50u);
+    for (size_t i{0}; i < top.size(); ++i) {
+        EXPECT_EQ(top[i], expected[i].second);
+    }
+    EXPECT_EQ(static_cast<double>(big[big.nth_by_area(big.size() - 1, 4)]), -expected[0].first);
+    EXPECT_EQ(big.filter_by_area(0, 1e18, 4).size(), big.size());
+}
+
+TEST(FigureTest, Contains) {
+    for (const auto &angle : angles) {
+        std::vector<Point<double>> vertices = gen_regular_polygon_points<double>(8, 2, -1, angle, 3);
+        RegularPolygon<double, 8> oc(vertices);
+        InlineRegularPolygon<double, 8> inl(vertices);
+        const Point<double> centre = oc.calc_centre();
+        std::vector<Point<double>> probes;
+        std::vector<bool> expected;
+        for (const auto &v : vertices) {
+            probes.push_back(v);
+            expected.push_back(true);
+            probes.push_back(centre + (v - centre) * 0.99);
+            expected.push_back(true);
+            probes.push_back(centre + (v - centre) * 1.01);
+            expected.push_back(false);
+        }
+        probes.push_back(centre);
+        expected.push_back(true);
+        probes.push_back(centre + Point<double>(100, 0));
+        expected.push_back(false);
+        std::unique_ptr<bool[]> result(new bool[probes.size()]);
+        oc.contains(probes, std::span<bool>(result.get(), probes.size()));
+        for (size_t i{0}; i < probes.size(); ++i) {
+            EXPECT_EQ(result[i], expected[i]);
+            EXPECT_EQ(oc.contains(probes[i]), expected[i]);
+            EXPECT_EQ(inl.contains(probes[i]), expected[i]);
+        }
+    }
+    RegularPolygon<double, 3> tr(gen_regular_polygon_points<double>(3, 0, 0, 0, 1));
+    std::vector<Point<double>> probes(2);
+    bool result[1];
+    EXPECT_ANY_THROW(tr.contains(probes, std::span<bool>(result, 1)));
+
+    // Both overloads apply the same rule to points on and just outside the boundary.
+    const double eps = Point<double>::eps;
+    for (const auto &angle : angles) {
+        std::vector<Point<double>> vertices = gen_regular_polygon_points<double>(4, 0, 0, angle, 1);
+        RegularPolygon<double, 4> square(vertices);
+        InlineRegularPolygon<double, 4> inl(vertices);
+        const Point<double> centre = square.calc_centre();
+        std::vector<Point<double>> edge_probes;
+        for (size_t i{0}; i < vertices.size(); ++i) {
+            const Point<double> v = vertices[i];
+            const Point<double> middle = (v + vertices[(i + 1) % vertices.size()]) / 2;
+            const Point<double> out = (middle - centre) / (middle - centre).length();
+            for (double k : { 0.0, 0.5, 2.0 }) {
+                edge_probes.push_back(middle + out * (k * eps));
+                edge_probes.push_back(v + (v - centre) * (k * eps));
+            }
+        }
+        std::unique_ptr<bool[]> batch(new bool[edge_probes.size()]);
+        square.contains(edge_probes, std::span<bool>(batch.get(), edge_probes.size()));
+        std::unique_ptr<bool[]> inline_batch(new bool[edge_probes.size()]);
+        inl.contains(edge_probes, std::span<bool>(inline_batch.get(), edge_probes.size()));
+        for (size_t i{0}; i < edge_probes.size(); ++i) {
+            EXPECT_EQ(square.contains(edge_probes[i]), batch[i]);
+            EXPECT_EQ(inl.contains(edge_probes[i]), inline_batch[i]);
+            EXPECT_EQ(batch[i], inline_batch[i]);
+        }
+        EXPECT_TRUE(batch[0]);
+        EXPECT_TRUE(batch[2]);
+        EXPECT_FALSE(batch[4]);
+    }
+}
+
+TEST(MyArrayTest, FilterContaining) {
+    MyArray<RegularPolygon<double, 6>> arr(0);
+    for (int i{0}; i < 10; ++i) {
+        arr.emplace_back(gen_regular_polygon_points<double>(6, 2.0 * i, 0, 0, 1.5));
+    }
+    MyArray<Figure<double>*> figures{ &arr[0], &arr[1], &arr[2] };
+    const Point<double> between = (arr[3].calc_centre() + arr[4].calc_centre()) / 2.0;
+    EXPECT_EQ(arr.filter_containing(arr[3].calc_centre()), std::vector<size_t>{ 3 });
+    EXPECT_EQ(arr.filter_containing(between, 2), (std::vector<size_t>{ 3, 4 }));
+    EXPECT_TRUE(arr.filter_containing(Point<double>(0, 50)).empty());
+    EXPECT_EQ(figures.filter_containing(arr[1].calc_centre()), std::vector<size_t>{ 1 });
+}
+
+TEST(MyArrayTest, CopyOnWrite) {
+    constexpr int v{6};
+    MyArray<RegularPolygon<double, v>> arr(0);
+    for (int i{0}; i < 5; ++i) {
+        arr.emplace_back(gen_regular_polygon_points<double>(v, i, i, 0, 1 + i));
+    }
+    auto first = [](const MyArray<RegularPolygon<double, v>>& a) { return &a[0]; };
+
+    MyArray<RegularPolygon<double, v>> copy(arr);
+    MyArray<RegularPolygon<double, v>> assigned(0);
+    assigned = arr;
+    EXPECT_EQ(first(copy), first(arr));
+    EXPECT_EQ(first(assigned), first(arr));
+    EXPECT_TRUE(scalar_eq(copy.total_square(), arr.total_square()));
+
+    // Only the mutated side detaches.
+    copy.remove(0);
+    EXPECT_EQ(copy.size(), 4u);
+    EXPECT_EQ(arr.size(), 5u);
+    EXPECT_NE(first(copy), first(arr));
+    EXPECT_EQ(first(assigned), first(arr));
+
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (const auto &p : gen_regular_polygon_points<double>(v, 0, 0, 0, 10)) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    assigned.read(1, ss);
+    EXPECT_TRUE(scalar_eq(assigned[1].side_length(), 10.0));
+    EXPECT_TRUE(scalar_eq(std::as_const(arr)[1].side_length(), 2.0));
+
+    MyArray<RegularPolygon<double, v>> pushed(arr);
+    pushed.push_back(RegularPolygon<double, v>());
+    EXPECT_EQ(pushed.size(), 6u);
+    EXPECT_EQ(arr.size(), 5u);
+    MyArray<RegularPolygon<double, v>> translated(arr);
+    translated.translate(Point<double>(1, 0));
+    EXPECT_TRUE(std::as_const(arr)[0].calc_centre() == std::as_const(translated)[0].calc_centre() - Point<double>(1, 0));
+
+    // Copies into another resource are deep.
+    std::pmr::monotonic_buffer_resource arena;
+    MyArray<RegularPolygon<double, v>> arena_copy(arr, &arena);
+    EXPECT_NE(first(arena_copy), first(arr));
+    EXPECT_EQ(arena_copy[0].get_allocator().resource(), &arena);
+
+    // The last owner mutates in place.
+    const RegularPolygon<double, v> *before = first(arr);
+    copy = MyArray<RegularPolygon<double, v>>(0);
+    assigned = copy;
+    pushed = copy;
+    translated = copy;
+    arr.swap_remove(4);
+    EXPECT_EQ(first(arr), before);
+}
+
+TEST(MyArrayTest, SharedCopiesReadConcurrently) {
+    constexpr int v{6};
+    MyArray<RegularPolygon<double, v>> arr(0);
+    double expected{0};
+    for (int i{0}; i < 200; ++i) {
+        arr.push_back(RegularPolygon<double, v>(gen_regular_polygon_points<double>(v, i, -i, 0, 1 + 0.01 * i)));
+        expected += regular_polygon_square<double>(v, 1 + 0.01 * i);
+    }
+    arr.set_metrics_caching(true);
+    const MyArray<RegularPolygon<double, v>> first_copy(arr);
+    const MyArray<RegularPolygon<double, v>> second_copy(arr);
+    double totals[2]{};
+    std::thread reader([&] {
+        totals[0] = first_copy.total_square();
+    });
+    totals[1] = second_copy.total_square();
+    reader.join();
+    EXPECT_NEAR(totals[0], expected, expected * 1e-12);
+    EXPECT_NEAR(totals[1], expected, expected * 1e-12);
+    EXPECT_TRUE(scalar_eq(static_cast<double>(first_copy[3]), static_cast<double>(second_copy[3])));
+
+    MyArray<RegularPolygon<double, v>> detached(first_copy);
+    detached.scale(2);
+    EXPECT_NEAR(detached.total_square(), 4 * expected, expected * 1e-9);
+    EXPECT_NEAR(first_copy.total_square(), expected, expected * 1e-12);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "../include/figure_binary.h"
+#include "./test.h"
+#include <filesystem>
+#include <fstream>
+#include <cmath>
+
+TEST(FigureBinaryTest, SaveAndMap) {
+    constexpr int v{6};
+    MyArray<RegularPolygon<double, v>> arr(0);
+    for (int i{0}; i < 50; ++i) {
+        arr.push_back(RegularPolygon<double, v>(gen_regular_polygon_points<double>(v, i, -i, 0.1 * i, 1 + i)));
+    }
+    const std::string path = temp_path("figure_binary_test.bin");
+    save_binary(path, arr);
+    EXPECT_EQ(std::filesystem::file_size(path), sizeof(FigureFileHeader) + 50 * v * sizeof(Point<double>));
+
+    MappedFigures<double, v> mapped(path);
+    ASSERT_EQ(mapped.size(), arr.size());
+    EXPECT_EQ(mapped.points().size(), 50u * v);
+    for (size_t i{0}; i < mapped.size(); ++i) {
+        for (int j{0}; j < v; ++j) {
+            EXPECT_TRUE(mapped[i][j] == arr[i][j]);
+        }
+        EXPECT_TRUE(mapped.calc_centre(i) == arr[i].calc_centre());
+        EXPECT_TRUE(scalar_eq(mapped.square(i), static_cast<double>(arr[i])));
+    }
+    EXPECT_TRUE(scalar_eq(mapped.total_square(), arr.total_square()));
+    EXPECT_TRUE((mapped.figure(3) == InlineRegularPolygon<double, v>(arr[3])));
+    EXPECT_ANY_THROW(mapped[50]);
+
+    EXPECT_ANY_THROW((MappedFigures<double, 8>(path)));
+    EXPECT_ANY_THROW((MappedFigures<float, v>(path)));
+    std::filesystem::remove(path);
+}
+
+TEST(FigureBinaryTest, InvalidFiles) {
+    EXPECT_ANY_THROW((MappedFigures<double, 3>(temp_path("figure_binary_missing.bin"))));
+
+    const std::string path = temp_path("figure_binary_invalid.bin");
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << "not a figure file at all";
+    }
+    EXPECT_ANY_THROW((MappedFigures<double, 3>(path)));
+
+    MyArray<InlineRegularPolygon<float, 3>> arr(4);
+    save_binary(path, arr);
+    EXPECT_EQ((MappedFigures<float, 3>(path).size()), 4u);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_ANY_THROW((MappedFigures<float, 3>(path)));
+    std::filesystem::remove(path);
+}
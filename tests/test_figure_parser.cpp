@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "../include/figure_parser.h"
+#include "./test.h"
+#include <sstream>
+#include <iomanip>
+#include <string>
+
+TEST(FigureParserTest, Record) {
+    std::array<Point<double>, 3> points;
+    EXPECT_EQ((parse_figure_record<double, 3>("0 0  1 1.5\t-2 3e2 ", points)), nullptr);
+    EXPECT_TRUE(points[1] == Point<double>(1, 1.5));
+    EXPECT_TRUE(points[2] == Point<double>(-2, 300));
+    EXPECT_NE((parse_figure_record<double, 3>("0 0 1 1 2", points)), nullptr);
+    EXPECT_NE((parse_figure_record<double, 3>("0 0 1 1 2 2 3", points)), nullptr);
+    EXPECT_NE((parse_figure_record<double, 3>("0 0 1 1x 2 2", points)), nullptr);
+    EXPECT_NE((parse_figure_record<double, 3>("0 0 1 , 2 2", points)), nullptr);
+    EXPECT_NE((parse_figure_record<double, 3>("0 0 nan 1 2 2", points)), nullptr);
+    EXPECT_NE((parse_figure_record<double, 3>("0 0 1 inf 2 2", points)), nullptr);
+    EXPECT_NE((parse_figure_record<double, 3>("0 0 1 1 -infinity 2", points)), nullptr);
+}
+
+TEST(FigureParserTest, NonFinite) {
+    constexpr int v{3};
+    std::string buffer = figure_line(gen_regular_polygon_points<double>(v, 0, 0, 0, 1)) +
+            "nan nan nan nan nan nan\n" + "0 0 inf 1 2 0\n";
+    MyArray<InlineRegularPolygon<double, v>> arr(0);
+    ParseResult result = parse_figures<double, v>(buffer, arr);
+    EXPECT_EQ(result.parsed, 1u);
+    ASSERT_EQ(result.errors.size(), 2u);
+    EXPECT_EQ(result.errors[0].line, 2u);
+    EXPECT_EQ(result.errors[1].line, 3u);
+    EXPECT_EQ(arr.size(), 1u);
+}
+
+TEST(FigureParserTest, Buffer) {
+    constexpr int v{6};
+    std::vector<Point<double>> h1 = gen_regular_polygon_points<double>(v, 4, 4, 0, 3.3);
+    std::vector<Point<double>> h2 = gen_regular_polygon_points<double>(v, -1, 2, 0.5, 10);
+    std::string buffer = figure_line(h1) + "\n" + "0 0 0 1 1 1 2 0.5 2 0 1 -1\n" + "1 2 3\n" + figure_line(h2);
+    buffer.pop_back();
+
+    FigureStore<double, v> store(0);
+    ParseResult result = parse_figures<double, v>(buffer, store);
+    EXPECT_EQ(result.parsed, 2u);
+    ASSERT_EQ(result.errors.size(), 2u);
+    EXPECT_EQ(result.errors[0].line, 3u);
+    EXPECT_EQ(result.errors[1].line, 4u);
+    ASSERT_EQ(store.size(), 2u);
+    EXPECT_TRUE(store.calc_centre(0) == mean(h1));
+    EXPECT_TRUE(store.calc_centre(1) == mean(h2));
+
+    MyArray<InlineRegularPolygon<double, v>> arr(0);
+    result = parse_figures<double, v>(buffer, arr);
+    EXPECT_EQ(result.parsed, 2u);
+    EXPECT_EQ(result.errors.size(), 2u);
+    ASSERT_EQ(arr.size(), 2u);
+    EXPECT_TRUE(scalar_eq(arr.total_square(), store.total_square()));
+    for (int j{0}; j < v; ++j) {
+        EXPECT_TRUE(arr[1][j] == h2[j]);
+    }
+}
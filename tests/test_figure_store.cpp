@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../include/figure_store.h"
+#include "../include/my_array.h"
+#include "../include/inline_regular_polygon.h"
+#include "./test.h"
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+
+TEST(FigureStoreTest, ConstructorDefault) {
+    FigureStore<double, 6> store(4);
+    RegularPolygon<double, 6> figure;
+    EXPECT_EQ(store.size(), 4u);
+    for (size_t i{0}; i < store.size(); ++i) {
+        for (int j{0}; j < 6; ++j) {
+            EXPECT_TRUE(store.vertex(i, j) == figure[j]);
+        }
+    }
+}
+
+TEST(FigureStoreTest, MatchesMyArray) {
+    const double pi = std::numbers::pi;
+    RegularPolygon<double, 6> h1(gen_regular_polygon_points<double>(6, 4, 4, 0, 3.3));
+    RegularPolygon<double, 6> h2(gen_regular_polygon_points<double>(6, 1.5, 2.5, pi, 10));
+    RegularPolygon<double, 6> h3(gen_regular_polygon_points<double>(6, 0, 0, pi/2, 1));
+    FigureStore<double, 6> store{ h1, h2, h3 };
+    MyArray<RegularPolygon<double, 6>> arr{ h1, h2, h3 };
+    EXPECT_TRUE(scalar_eq(store.total_square(), arr.total_square()));
+    EXPECT_TRUE(store.calc_centre(0) == h1.calc_centre());
+    EXPECT_TRUE(store.calc_centre(1) == h2.calc_centre());
+    EXPECT_TRUE(store.calc_centre(2) == h3.calc_centre());
+    EXPECT_TRUE(store[1] == h2);
+
+    store.remove(1);
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_TRUE(store.calc_centre(1) == h3.calc_centre());
+    EXPECT_TRUE(scalar_eq(store.total_square(), static_cast<double>(h1) + static_cast<double>(h3)));
+    EXPECT_ANY_THROW(store.remove(2));
+}
+
+TEST(FigureStoreTest, Read) {
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(3, 1, 2, 0.5, 4);
+    FigureStore<double, 3> store(2);
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (const auto &p : points) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    EXPECT_NO_THROW(store.read(1, ss));
+    for (int j{0}; j < 3; ++j) {
+        EXPECT_TRUE(store.vertex(1, j) == points[j]);
+    }
+    std::stringstream bad("0 0 0 1 1 1");
+    EXPECT_ANY_THROW(store.read(0, bad));
+    EXPECT_ANY_THROW(store.read(2, ss));
+    EXPECT_NO_THROW(store.print(std::cout));
+    EXPECT_NO_THROW(store.print_centres(std::cout));
+    EXPECT_NO_THROW(store.print_squares(std::cout));
+}
+
+TEST(FigureStoreTest, AdmittedFiguresMaterialize) {
+    FigureStore<double, 6> store(0);
+    FigureStore<float, 6> float_store(0);
+    for (double side : { 5e-4, 1e-3, 1e-2 }) {
+        std::vector<Point<double>> points = gen_regular_polygon_points<double>(6, 1, -1, 0.2, side);
+        ASSERT_TRUE((store.try_push_back(std::span<const Point<double>, 6>(points.data(), 6))));
+        EXPECT_TRUE((InlineRegularPolygon<double, 6>::make(std::span<const Point<double>, 6>(points.data(), 6))));
+        std::vector<Point<float>> float_points = gen_regular_polygon_points<float>(6, 1, -1, 0.2f, static_cast<float>(side) * 10);
+        ASSERT_TRUE((float_store.try_push_back(std::span<const Point<float>, 6>(float_points.data(), 6))));
+    }
+    for (size_t i{0}; i < store.size(); ++i) {
+        EXPECT_NO_THROW(store[i]);
+        EXPECT_NO_THROW(float_store[i]);
+    }
+    std::stringstream ss;
+    EXPECT_NO_THROW(store.print(ss));
+    EXPECT_NO_THROW(float_store.print(ss));
+}
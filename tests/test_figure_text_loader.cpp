@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../include/figure_text_loader.h"
+#include "./test.h"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+TEST(FigureTextLoaderTest, PrintedRecord) {
+    constexpr int v{3};
+    std::array<Point<double>, v> points;
+    EXPECT_EQ((parse_printed_figure_record<double, v>("Triangle: [ (0, 0), (1, 2), (2, 0) ]", points)), nullptr);
+    EXPECT_TRUE(points[1] == Point<double>(1, 2));
+    EXPECT_EQ((parse_printed_figure_record<double, v>("  7: Triangle: [(0,0),(1,2),(2,0)]  ", points)), nullptr);
+    EXPECT_EQ((parse_printed_figure_record<double, v>("[ (0, 0), (1, 2), (2, 0) ]", points)), nullptr);
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Hexagone: [ (0, 0), (1, 2), (2, 0) ]", points)), "Unexpected figure name");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Triangle: (0, 0), (1, 2), (2, 0)", points)), "Missing '['");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Triangle: [ (0, 0), (1, 2) ]", points)), "Too few points");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Triangle: [ (0, 0), (1, x), (2, 0) ]", points)), "Invalid point");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Triangle: [ (0, 0), (1, 2), (2, 0), (3, 3) ]", points)), "Too many points");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Triangle: [ (0, 0), (1, 2), (2, 0) ] 1", points)), "Unexpected text after ']'");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Triangle: [ (0, 0), (nan, 2), (2, 0) ]", points)), "Invalid point");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("Triangle: [ (0, 0), (1, inf), (2, 0) ]", points)), "Invalid point");
+    EXPECT_STREQ((parse_printed_figure_record<double, v>("[ (-infinity, 0), (1, 2), (2, 0) ]", points)), "Invalid point");
+    EXPECT_EQ(regular_polygon_name(5), "RegularPolygon(5)");
+}
+
+TEST(FigureTextLoaderTest, ChunksMatchSerialParse) {
+    constexpr int v{6};
+    MyArray<InlineRegularPolygon<double, v>> arr(0);
+    for (int i{0}; i < 200; ++i) {
+        arr.push_back(InlineRegularPolygon<double, v>(gen_regular_polygon_points<double>(v, i, -i, 0.01 * i, 1 + 0.5 * i)));
+    }
+    std::stringstream ss;
+    ss << std::setprecision(17);
+    arr.print(ss);
+    std::string text = ss.str();
+    text += "\nOctagon: [ (0, 0) ]\n";
+    text += "Hexagone: [ (0, 0), (1, 0), (2, 0), (3, 0), (4, 0), (5, 0) ]\n";
+    text += "garbage\n";
+    text += "Hexagone: [ (nan, nan), (nan, nan), (nan, nan), (nan, nan), (nan, nan), (nan, nan) ]\n";
+    ss.str("");
+    ss << arr[0] << "\n" << arr[1];
+    text += ss.str();
+
+    MyArray<InlineRegularPolygon<double, v>> serial(0);
+    ParseResult expected = parse_printed_figures<double, v>(text, [&serial](std::span<const Point<double>, v> points) {
+        std::optional<InlineRegularPolygon<double, v>> figure = InlineRegularPolygon<double, v>::make(points);
+        if (figure) {
+            serial.push_back(*figure);
+        }
+        return figure.has_value();
+    });
+    ASSERT_EQ(expected.parsed, 202u);
+    ASSERT_EQ(expected.errors.size(), 4u);
+    EXPECT_EQ(expected.errors[0].line, 202u);
+    EXPECT_STREQ(expected.errors[0].message, "Unexpected figure name");
+    EXPECT_STREQ(expected.errors[1].message, "Invalid sides");
+    EXPECT_EQ(expected.errors[2].line, 204u);
+    EXPECT_EQ(expected.errors[3].line, 205u);
+    EXPECT_STREQ(expected.errors[3].message, "Invalid point");
+
+    for (size_t threads : {1u, 3u}) {
+        for (size_t chunk_size : {size_t{1}, size_t{500}, text_chunk_size}) {
+            MyArray<InlineRegularPolygon<double, v>> loaded(0);
+            ParseResult result = parse_printed_figures<double, v>(text, loaded, threads, chunk_size);
+            EXPECT_EQ(result.parsed, expected.parsed);
+            ASSERT_EQ(result.errors.size(), expected.errors.size());
+            for (size_t i{0}; i < result.errors.size(); ++i) {
+                EXPECT_EQ(result.errors[i].line, expected.errors[i].line);
+                EXPECT_STREQ(result.errors[i].message, expected.errors[i].message);
+            }
+            ASSERT_EQ(loaded.size(), serial.size());
+            for (size_t i{0}; i < loaded.size(); ++i) {
+                EXPECT_TRUE(loaded[i].calc_centre() == serial[i].calc_centre());
+                EXPECT_TRUE(loaded[i] == serial[i]);
+            }
+        }
+    }
+}
+
+TEST(FigureTextLoaderTest, LoadFile) {
+    constexpr int v{8};
+    MyArray<InlineRegularPolygon<float, v>> arr(0);
+    for (int i{0}; i < 100; ++i) {
+        arr.push_back(InlineRegularPolygon<float, v>(gen_regular_polygon_points<float>(v, i, i, 0, 2 + i % 5)));
+    }
+    const std::string path = temp_path("figure_text_loader_test.txt");
+    {
+        std::ofstream file(path);
+        file << std::setprecision(9);
+        arr.print(file);
+    }
+    MyArray<InlineRegularPolygon<float, v>> loaded(0);
+    ParseResult result = load_printed_figures<float, v>(path, loaded);
+    EXPECT_EQ(result.parsed, arr.size());
+    EXPECT_TRUE(result.errors.empty());
+    ASSERT_EQ(loaded.size(), arr.size());
+    for (size_t i{0}; i < loaded.size(); ++i) {
+        EXPECT_TRUE(loaded[i].calc_centre() == arr[i].calc_centre());
+    }
+    std::filesystem::remove(path);
+    EXPECT_ANY_THROW((load_printed_figures<float, v>(path, loaded)));
+}
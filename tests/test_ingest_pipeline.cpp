@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "../include/ingest_pipeline.h"
+#include "./test.h"
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <thread>
+
+TEST(SpscQueueTest, Basic) {
+    SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    int value{0};
+    EXPECT_FALSE(queue.try_pop(value));
+    for (int i{0}; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.try_push(4));
+    EXPECT_ANY_THROW(SpscQueue<int>(0));
+}
+
+TEST(SpscQueueTest, Threads) {
+    SpscQueue<size_t> queue(16);
+    constexpr size_t n{100000};
+    std::thread producer([&queue] {
+        for (size_t i{0}; i < n; ++i) {
+            while (!queue.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    size_t expected{0};
+    size_t value;
+    while (expected < n) {
+        if (queue.try_pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(IngestPipelineTest, MatchesParser) {
+    constexpr int v{8};
+    std::string buffer;
+    for (size_t i{0}; i < 5000; ++i) {
+        if (i % 97 == 0) {
+            buffer += "0 0 0 1 1 1 2 0.5 2 0 1 -1 0 0 3 3\n";
+        } else if (i % 101 == 0) {
+            buffer += "1 2 3\n\n";
+        } else {
+            buffer += figure_line(gen_regular_polygon_points<double>(v, i % 100, -1.0 * (i % 37), 0.01 * i, 1 + i % 7));
+        }
+    }
+    MyArray<InlineRegularPolygon<double, v>> expected(0);
+    ParseResult parsed = parse_figures<double, v>(buffer, expected);
+
+    for (size_t validators : { 1, 3, 0 }) {
+        MyArray<InlineRegularPolygon<double, v>> arr(0);
+        IngestResult result = ingest_figures<double, v>(buffer, arr, validators, 8);
+        EXPECT_EQ(result.parsed, parsed.parsed);
+        ASSERT_EQ(result.errors.size(), parsed.errors.size());
+        for (size_t i{0}; i < parsed.errors.size(); ++i) {
+            EXPECT_EQ(result.errors[i].line, parsed.errors[i].line);
+        }
+        ASSERT_EQ(arr.size(), expected.size());
+        for (size_t i{0}; i < arr.size(); ++i) {
+            EXPECT_TRUE(arr[i][0] == expected[i][0]);
+        }
+        EXPECT_EQ(result.stats.parse.items, parsed.parsed + parsed.errors.size());
+        EXPECT_EQ(result.stats.validate.items, result.stats.parse.items);
+        EXPECT_EQ(result.stats.commit.items, result.stats.parse.items);
+        EXPECT_GT(result.stats.validators_number, 0u);
+        EXPECT_GT(result.stats.elapsed_nanoseconds, 0u);
+    }
+}
+
+TEST(IngestPipelineTest, NonFinite) {
+    constexpr int v{3};
+    std::string buffer = figure_line(gen_regular_polygon_points<double>(v, 0, 0, 0, 1)) +
+            "nan nan nan nan nan nan\n" + "0 0 inf 1 2 0\n" + "0 0 1 1.7320508075688772 NaN 0\n" +
+            figure_line(gen_regular_polygon_points<double>(v, 5, 5, 0, 2));
+    MyArray<InlineRegularPolygon<double, v>> arr(0);
+    IngestResult result = ingest_figures<double, v>(buffer, arr, 2, 4);
+    EXPECT_EQ(result.parsed, 2u);
+    ASSERT_EQ(result.errors.size(), 3u);
+    EXPECT_EQ(result.errors[0].line, 2u);
+    EXPECT_EQ(result.errors[2].line, 4u);
+    ASSERT_EQ(arr.size(), 2u);
+    for (size_t i{0}; i < arr.size(); ++i) {
+        EXPECT_TRUE(std::isfinite(static_cast<double>(arr[i])));
+    }
+}
+
+TEST(IngestPipelineTest, SinkException) {
+    std::string buffer;
+    for (size_t i{0}; i < 1000; ++i) {
+        buffer += figure_line(gen_regular_polygon_points<double>(3, i, 0, 0, 1));
+    }
+    size_t calls{0};
+    EXPECT_THROW((ingest_figures<double, 3>(buffer, [&calls](std::span<const Point<double>, 3>) {
+        if (++calls == 10) {
+            throw std::runtime_error("Sink failed");
+        }
+    }, 2, 4)), std::runtime_error);
+    EXPECT_EQ(calls, 10u);
+
+    IngestResult empty = ingest_figures<double, 3>("", [](std::span<const Point<double>, 3>) {}, 2);
+    EXPECT_EQ(empty.parsed, 0u);
+    EXPECT_TRUE(empty.errors.empty());
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "../include/inline_regular_polygon.h"
+#include "../include/my_array.h"
+#include "./test.h"
+#include <sstream>
+#include <iomanip>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<InlineRegularPolygon<double, 3>>);
+static_assert(std::is_trivially_copyable_v<InlineRegularPolygon<double, 6>>);
+static_assert(std::is_trivially_copyable_v<InlineRegularPolygon<double, 8>>);
+static_assert(sizeof(InlineRegularPolygon<double, 8>) == 8 * sizeof(Point<double>));
+
+template <int V>
+static void check_matches_regular_polygon() {
+    const double pi = std::numbers::pi;
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(V, 1.5, -2, pi/7, 4.2);
+    RegularPolygon<double, V> heap(points);
+    InlineRegularPolygon<double, V> inl(points);
+    EXPECT_EQ(inl.get_vertices_number(), V);
+    for (int i{0}; i < V; ++i) {
+        EXPECT_TRUE(inl[i] == heap[i]);
+    }
+    EXPECT_ANY_THROW(inl[V]);
+    EXPECT_TRUE(inl.calc_centre() == heap.calc_centre());
+    EXPECT_TRUE(scalar_eq(static_cast<double>(inl), static_cast<double>(heap)));
+    EXPECT_TRUE((inl == InlineRegularPolygon<double, V>(heap)));
+
+    std::stringstream heap_out;
+    std::stringstream inline_out;
+    heap_out << heap;
+    inline_out << inl;
+    EXPECT_EQ(heap_out.str(), inline_out.str());
+}
+
+TEST(InlineRegularPolygonTest, MatchesRegularPolygon) {
+    check_matches_regular_polygon<3>();
+    check_matches_regular_polygon<6>();
+    check_matches_regular_polygon<8>();
+}
+
+TEST(InlineRegularPolygonTest, Validation) {
+    EXPECT_ANY_THROW((InlineRegularPolygon<double, 6>(gen_regular_polygon_points<double>(8, 0, 0, 0, 1))));
+    EXPECT_ANY_THROW((InlineRegularPolygon<double, 6>(gen_regular_polygon_points<double>(6, 0, 0, 0, 0))));
+    InlineRegularPolygon<double, 3> tr;
+    std::stringstream ss("0 0 0 1 1 1");
+    EXPECT_ANY_THROW(ss >> tr);
+    EXPECT_TRUE((tr == InlineRegularPolygon<double, 3>()));
+}
+
+TEST(InlineRegularPolygonTest, MyArray) {
+    constexpr int v{6};
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(v, 4, 4, 0, 3.3);
+    MyArray<InlineRegularPolygon<double, v>> arr(3);
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (const auto &p : points) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    EXPECT_NO_THROW(arr.read(1, ss));
+    RegularPolygon<double, v> expected(points);
+    EXPECT_TRUE(scalar_eq(arr.total_square(), 2 * static_cast<double>(RegularPolygon<double, v>()) + static_cast<double>(expected)));
+    EXPECT_NO_THROW(arr.print(std::cout));
+    EXPECT_NO_THROW(arr.remove(0));
+    EXPECT_EQ(arr.size(), 2u);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "../include/instrumentation.h"
+#include "../include/regular_polygon.h"
+#include "../include/my_array.h"
+#include "../include/figure_parser.h"
+#include "./test.h"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using instrumentation::Counter;
+using instrumentation::Timer;
+
+TEST(InstrumentationTest, Enabled) {
+    EXPECT_TRUE(instrumentation::enabled);
+}
+
+TEST(InstrumentationTest, CopiesMovesAndAllocations) {
+    std::vector<Point<double>> points = gen_regular_polygon_points<double>(6, 0, 0, 0, 1);
+    instrumentation::reset();
+    RegularPolygon<double, 6> hex(points);
+    RegularPolygon<double, 6> copy(hex);
+    RegularPolygon<double, 6> moved(std::move(copy));
+    copy = hex;
+    hex = std::move(moved);
+    instrumentation::Snapshot snapshot = instrumentation::snapshot();
+    EXPECT_EQ(snapshot[Counter::figure_copies], 2);
+    EXPECT_EQ(snapshot[Counter::figure_moves], 2);
+    EXPECT_EQ(snapshot[Counter::point_allocations], 3);
+    EXPECT_EQ(snapshot[Timer::construction].calls, 1);
+    EXPECT_EQ(snapshot[Timer::validation].calls, 1);
+    EXPECT_EQ(snapshot[Counter::validation_rejects], 0);
+
+    points[2] = Point<double>(5, 5);
+    EXPECT_ANY_THROW((RegularPolygon<double, 6>(points)));
+    EXPECT_EQ(instrumentation::snapshot()[Counter::validation_rejects], 1);
+}
+
+TEST(InstrumentationTest, ArrayOperations) {
+    instrumentation::reset();
+    MyArray<RegularPolygon<double, 3>> arr(0);
+    for (int i{0}; i < 5; ++i) {
+        arr.emplace_back(gen_regular_polygon_points<double>(3, i, i, 0, 1));
+    }
+    arr.remove(1);
+    arr.total_square(2);
+    arr.calc_centres();
+    std::stringstream ss;
+    arr.print(ss);
+    instrumentation::Snapshot snapshot = instrumentation::snapshot();
+    EXPECT_EQ(snapshot[Counter::array_reallocations], 2);
+    EXPECT_EQ(snapshot[Counter::remove_shifts], 3);
+    EXPECT_EQ(snapshot[Counter::records_written], 4);
+    EXPECT_EQ(snapshot[Timer::aggregation].calls, 2);
+    EXPECT_EQ(snapshot[Timer::print].calls, 1);
+    EXPECT_EQ(snapshot[Counter::array_detaches], 0);
+
+    MyArray<RegularPolygon<double, 3>> shared(arr);
+    shared.remove(0);
+    EXPECT_EQ(instrumentation::snapshot()[Counter::array_detaches], 1);
+
+    MyArray<InlineRegularPolygon<double, 3>> parsed(0);
+    std::string text = "0 0 0 1 0.8660254037844386 0.5\n1 2 3\n0 0 0 1 1 1\n";
+    parse_figures<double, 3>(text, parsed);
+    snapshot = instrumentation::snapshot();
+    EXPECT_EQ(snapshot[Counter::records_read], 1);
+    EXPECT_EQ(snapshot[Counter::validation_rejects], 1);
+    EXPECT_EQ(snapshot[Timer::read].calls, 1);
+}
+
+TEST(InstrumentationTest, ThreadsAndDump) {
+    instrumentation::reset();
+    std::vector<std::thread> threads;
+    for (int t{0}; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i{0}; i < 1000; ++i) {
+                instrumentation::count(Counter::remove_shifts);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    instrumentation::count(Counter::remove_shifts, 5);
+    {
+        FIGURE_TIME(aggregation);
+    }
+    instrumentation::Snapshot snapshot = instrumentation::snapshot();
+    EXPECT_EQ(snapshot[Counter::remove_shifts], 4005);
+    EXPECT_EQ(snapshot[Timer::aggregation].calls, 1);
+
+    std::stringstream ss;
+    instrumentation::dump(ss, snapshot);
+    EXPECT_NE(ss.str().find("remove_shifts 4005\n"), std::string::npos);
+    EXPECT_NE(ss.str().find("aggregation 1 "), std::string::npos);
+    instrumentation::reset();
+    EXPECT_EQ(instrumentation::snapshot()[Counter::remove_shifts], 0);
+}
@@ -486,4 +486,15 @@ TEST(PointTest, Read) {
 
     Point<double> vE; std::stringstream ssE("500000 -700000"); vE.read(ssE);
     EXPECT_TRUE(scalar_eq<double>(vE.get_x(), 5e5)); EXPECT_TRUE(scalar_eq<double>(vE.get_y(), -7e5));
-}
\ No newline at end of file
+}
+
+TEST(PointTest, Tolerance) {
+    EXPECT_FLOAT_EQ(Point<float>::eps, 1e-4f);
+    EXPECT_DOUBLE_EQ(Point<double>::eps, 1e-6);
+    EXPECT_TRUE(Point<float>(1000.0f, -2000.0f) == Point<float>(1000.01f, -2000.01f));
+    EXPECT_FALSE(Point<float>(1000.0f, 0.0f) == Point<float>(1000.1f, 0.0f));
+    EXPECT_TRUE(Point<double>(1, 2) == Point<double>(1 + 5e-7, 2));
+    EXPECT_FALSE(Point<double>(1, 2) == Point<double>(1 + 2e-6, 2));
+    EXPECT_TRUE(approx_equal(1e9, 1e9 + 1e-4));
+    EXPECT_FALSE(approx_equal(1e9, 1e9 + 1e-2));
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "../include/point_batch.h"
+#include "./test.h"
+#include <vector>
+#include <cmath>
+
+template <Scalar T>
+static std::vector<Point<T>> make_points(size_t n, T shift) {
+    std::vector<Point<T>> points;
+    for (size_t i{0}; i < n; ++i) {
+        points.emplace_back(static_cast<T>(i) * T(0.5) - shift, T(3) - static_cast<T>(i) * T(0.25) + shift);
+    }
+    return points;
+}
+
+template <Scalar T>
+static void check_batch_ops(T tolerance) {
+    for (size_t n{0}; n < 21; ++n) {
+        std::vector<Point<T>> a = make_points<T>(n, T(1.5));
+        std::vector<Point<T>> b = make_points<T>(n, T(-2));
+
+        std::vector<Point<T>> sum = a;
+        batch_add<T>(sum, b);
+        std::vector<Point<T>> diff = a;
+        batch_sub<T>(diff, b);
+        std::vector<Point<T>> scaled = a;
+        batch_scale<T>(scaled, T(-2.5));
+        std::vector<Point<T>> rotated = a;
+        batch_rotate<T>(rotated, T(0.7));
+        std::vector<Point<T>> affine = a;
+        batch_affine<T>(affine, T(1.5), T(-0.5), T(2), T(0.25), Point<T>(T(3), T(-1)));
+        std::vector<T> dot(n);
+        batch_scalar_product<T>(a, b, dot);
+        std::vector<T> cross(n);
+        batch_vector_product_factor<T>(a, b, cross);
+        std::vector<T> length(n);
+        batch_length<T>(a, length);
+
+        for (size_t i{0}; i < n; ++i) {
+            EXPECT_TRUE(sum[i] == a[i] + b[i]);
+            EXPECT_TRUE(diff[i] == a[i] - b[i]);
+            EXPECT_TRUE(scaled[i] == a[i] * T(-2.5));
+            EXPECT_NEAR(rotated[i].get_x(), a[i].rotate(T(0.7)).get_x(), tolerance);
+            EXPECT_NEAR(rotated[i].get_y(), a[i].rotate(T(0.7)).get_y(), tolerance);
+            EXPECT_NEAR(affine[i].get_x(), T(1.5) * a[i].get_x() - T(0.5) * a[i].get_y() + T(3), tolerance);
+            EXPECT_NEAR(affine[i].get_y(), T(2) * a[i].get_x() + T(0.25) * a[i].get_y() - T(1), tolerance);
+            EXPECT_NEAR(dot[i], scalar_product(a[i], b[i]), tolerance);
+            EXPECT_NEAR(cross[i], vector_product_factor(a[i], b[i]), tolerance);
+            EXPECT_NEAR(length[i], a[i].length(), tolerance);
+        }
+    }
+}
+
+TEST(PointBatchTest, Double) {
+    check_batch_ops<double>(1e-9);
+}
+
+TEST(PointBatchTest, Float) {
+    check_batch_ops<float>(1e-4f);
+}
+
+TEST(PointBatchTest, SizeMismatch) {
+    std::vector<Point<double>> a(3);
+    std::vector<Point<double>> b(4);
+    std::vector<double> out(3);
+    EXPECT_ANY_THROW(batch_add<double>(a, b));
+    EXPECT_ANY_THROW(batch_sub<double>(a, b));
+    EXPECT_ANY_THROW(batch_scalar_product<double>(a, b, out));
+    EXPECT_ANY_THROW(batch_vector_product_factor<double>(b, b, out));
+    EXPECT_ANY_THROW(batch_length<double>(b, out));
+}
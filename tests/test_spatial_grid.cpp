@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "../include/spatial_grid.h"
+#include "../include/regular_polygon.h"
+#include "./test.h"
+#include <limits>
+#include <vector>
+
+static std::vector<size_t> brute_window(const std::vector<Point<double>>& centres, Point<double> min, Point<double> max) {
+    std::vector<size_t> result;
+    for (size_t i{0}; i < centres.size(); ++i) {
+        if (centres[i].get_x() >= min.get_x() && centres[i].get_x() <= max.get_x() &&
+                centres[i].get_y() >= min.get_y() && centres[i].get_y() <= max.get_y()) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+static std::vector<size_t> brute_radius(const std::vector<Point<double>>& centres, Point<double> centre, double radius) {
+    std::vector<size_t> result;
+    for (size_t i{0}; i < centres.size(); ++i) {
+        if ((centres[i] - centre).length() <= radius) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+TEST(SpatialGridTest, Queries) {
+    MyArray<RegularPolygon<double, 6>> arr(0);
+    for (int i{0}; i < 500; ++i) {
+        double x = ((i * 37) % 200) - 100 + 0.25 * (i % 4);
+        double y = ((i * 53) % 160) - 80 - 0.5 * (i % 3);
+        arr.emplace_back(gen_regular_polygon_points<double>(6, x, y, 0.1 * i, 1 + i % 5));
+    }
+    std::vector<Point<double>> centres = arr.calc_centres();
+    SpatialGrid<double> grid = make_spatial_grid(arr, 7.5);
+    EXPECT_EQ(grid.size(), arr.size());
+
+    std::vector<std::pair<Point<double>, Point<double>>> windows{
+        { {-10, -10}, {10, 10} }, { {-100, -100}, {100, 100} }, { {-1e6, -1e6}, {1e6, 1e6} },
+        { {33.3, -70}, {34, 70} }, { {5, 5}, {-5, -5} }
+    };
+    for (const auto &[min, max] : windows) {
+        EXPECT_EQ(grid.query_window(min, max), brute_window(centres, min, max));
+    }
+    for (double radius : { 0.0, 1.0, 12.5, 60.0, 1000.0 }) {
+        EXPECT_EQ(grid.query_radius(Point<double>(3, -4), radius), brute_radius(centres, Point<double>(3, -4), radius));
+    }
+
+    std::vector<size_t> window = grid.query_window({-20, -20}, {20, 20});
+    ASSERT_FALSE(window.empty());
+    EXPECT_TRUE(grid.remove(window[0]));
+    EXPECT_FALSE(grid.remove(window[0]));
+    EXPECT_FALSE(grid.contains(window[0]));
+    std::vector<size_t> after = grid.query_window({-20, -20}, {20, 20});
+    EXPECT_EQ(after, std::vector<size_t>(window.begin() + 1, window.end()));
+
+    grid.insert(window[1], Point<double>(500, 500));
+    EXPECT_EQ(grid.query_window({499, 499}, {501, 501}), std::vector<size_t>{ window[1] });
+    EXPECT_EQ(grid.size(), arr.size() - 1);
+    EXPECT_ANY_THROW(SpatialGrid<double>(0.0));
+}
+
+TEST(SpatialGridTest, FarAndNonFiniteCentres) {
+    SpatialGrid<double> grid(1.0);
+    // Cells 2^32 apart used to share a truncated 32-bit key.
+    grid.insert(0, Point<double>(0.5, 0.5));
+    grid.insert(1, Point<double>(4294967296.5, 0.5));
+    grid.insert(2, Point<double>(1e300, -1e300));
+    EXPECT_EQ(grid.query_window({0, 0}, {1, 1}), std::vector<size_t>{ 0 });
+    EXPECT_EQ(grid.query_window({4294967296.0, 0}, {4294967297.0, 1}), std::vector<size_t>{ 1 });
+    EXPECT_EQ(grid.query_window({1e299, -1e301}, {1e301, -1e299}), std::vector<size_t>{ 2 });
+    EXPECT_EQ(grid.query_radius(Point<double>(1e300, -1e300), 1), std::vector<size_t>{ 2 });
+    EXPECT_EQ(grid.query_window({-1e300, -1e300}, {1e300, 1e300}), (std::vector<size_t>{ 0, 1, 2 }));
+    EXPECT_TRUE(grid.remove(2));
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    EXPECT_THROW(grid.insert(3, Point<double>(nan, 0)), std::invalid_argument);
+    EXPECT_THROW(grid.insert(3, Point<double>(0, inf)), std::invalid_argument);
+    EXPECT_THROW(grid.insert(0, Point<double>(-inf, 0)), std::invalid_argument);
+    EXPECT_TRUE(grid.contains(0));
+    EXPECT_EQ(grid.size(), 2u);
+    EXPECT_TRUE(grid.query_window({nan, nan}, {1, 1}).empty());
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../include/variant_array.h"
+#include "../include/my_array.h"
+#include "./test.h"
+#include <sstream>
+#include <iomanip>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<PolygonVariantArray<double>::figure_type>);
+
+TEST(VariantArrayTest, MatchesPointerArray) {
+    const double pi = std::numbers::pi;
+    RegularPolygon<double, 3> tr(gen_regular_polygon_points<double>(3, 4, 4, 0, 3.3));
+    RegularPolygon<double, 6> hexagon(gen_regular_polygon_points<double>(6, 1.5, 2.5, pi, 10));
+    RegularPolygon<double, 8> octagon(gen_regular_polygon_points<double>(8, 0, 0, pi/2, 1));
+    MyArray<Figure<double>*> pointers{ &tr, &hexagon, &octagon };
+
+    PolygonVariantArray<double> arr{
+        InlineRegularPolygon<double, 3>(tr), InlineRegularPolygon<double, 6>(hexagon)
+    };
+    arr.emplace_back<InlineRegularPolygon<double, 8>>(octagon);
+    ASSERT_EQ(arr.size(), 3u);
+    EXPECT_EQ(arr.get_vertices_number(0), 3);
+    EXPECT_EQ(arr.get_vertices_number(1), 6);
+    EXPECT_EQ(arr.get_vertices_number(2), 8);
+    EXPECT_TRUE(scalar_eq(arr.total_square(), pointers.total_square()));
+    EXPECT_EQ(arr.total_square(4), arr.total_square());
+    for (size_t i{0}; i < arr.size(); ++i) {
+        EXPECT_TRUE(arr.calc_centre(i) == pointers[i]->calc_centre());
+    }
+
+    std::stringstream expected;
+    std::stringstream actual;
+    pointers.print(expected);
+    arr.print(actual);
+    EXPECT_EQ(expected.str(), actual.str());
+    EXPECT_NO_THROW(arr.print_centres(std::cout));
+    EXPECT_NO_THROW(arr.print_squares(std::cout));
+
+    std::stringstream ss;
+    ss << std::setprecision(15);
+    for (const auto &p : gen_regular_polygon_points<double>(6, -3, 3, 0, 2)) {
+        ss << p.get_x() << " " << p.get_y() << " ";
+    }
+    arr.read(1, ss);
+    RegularPolygon<double, 6> read_hexagon(gen_regular_polygon_points<double>(6, -3, 3, 0, 2));
+    EXPECT_TRUE(arr.calc_centre(1) == read_hexagon.calc_centre());
+    std::stringstream bad("0 0 1 1 2 2");
+    EXPECT_ANY_THROW(arr.read(0, bad));
+
+    arr.swap_remove(0);
+    EXPECT_EQ(arr.get_vertices_number(0), 8);
+    arr.remove(0);
+    EXPECT_EQ(arr.size(), 1u);
+    EXPECT_EQ(arr.get_vertices_number(0), 6);
+    EXPECT_ANY_THROW(arr.remove(1));
+}